@@ -2,6 +2,64 @@
 
 #include <xstring>
 #include <tuple>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <memory_resource>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <optional>
+#include <cstring>
+#include <iterator>
+#include <functional>
+#include <string>
+#include <charconv>
+#include <cmath>
+#include <cfloat>
+#include <cstdio>
+#include <stdexcept>
+
+// Size in bytes of the inline buffer of rtti::value.
+// Nothrow movable objects which fit in it are stored without heap allocation.
+#ifndef RTTI_VALUE_INLINE_CAPACITY
+#define RTTI_VALUE_INLINE_CAPACITY (sizeof(void*) * 6)
+#endif
+
+// JSON text is scanned by SSE2 or AVX2 on x86, chosen at run time. Define RTTI_NO_SIMD to scan it by scalar code only.
+#if !defined(RTTI_NO_SIMD) && (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__))
+#define RTTI_SIMD_X86
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+#define RTTI_TARGET(isa) __attribute__((target(isa)))
+#else
+#define RTTI_TARGET(isa)
+#endif
+
+// Define RTTI_MAPPED_FILE to map archives from files by rtti::mapped_file.
+// It includes <windows.h> with NOMINMAX defined, or the POSIX mmap headers, which are left out otherwise.
+#if defined(RTTI_MAPPED_FILE)
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#endif
 
 namespace rtti
 {
@@ -119,6 +177,23 @@ namespace rtti
 			return hash(get_type_name<T>());
 		}
 
+		// Identifies the argument types of a signature after decay.
+		constexpr type_id_t signature_seed = 14695981039346656037ULL;
+		constexpr type_id_t combine_signature_id(type_id_t signature, type_id_t argument)
+		{
+			return (signature ^ argument) * 1099511628211ULL;
+		}
+		template<typename... Args> constexpr type_id_t get_signature_id()
+		{
+			type_id_t result = signature_seed;
+			((result = combine_signature_id(result, get_type_id<std::decay_t<Args>>())), ...);
+			return result;
+		}
+		template<typename... Args> constexpr type_id_t get_signature_id(type_list<Args...>)
+		{
+			return get_signature_id<Args...>();
+		}
+
 		struct noncopyable
 		{
 			constexpr noncopyable() {};
@@ -219,6 +294,86 @@ namespace rtti
 			return end;
 		}
 
+		struct name_index_entry
+		{
+			type_id_t	hash;
+			size_t		position;
+		};
+
+		// Positions of named items sorted by the hash of their names.
+		// Items sharing a hash keep their declaration order, so the first declared wins.
+		template<size_t Size>
+		class name_index
+		{
+		public:
+			constexpr name_index()
+				: m_entries{}
+			{}
+			template<typename Iterator>
+			constexpr name_index(Iterator items)
+				: m_entries{}
+			{
+				for (size_t i = 0; i < Size; ++i)
+				{
+					name_index_entry entry = { hash(items[i].name()), i };
+					auto j = i;
+					for (; j > 0 && entry.hash < m_entries[j - 1].hash; --j)
+						m_entries[j] = m_entries[j - 1];
+					m_entries[j] = entry;
+				}
+			}
+
+			constexpr const name_index_entry* data() const
+			{
+				if constexpr (Size == 0)
+					return nullptr;
+				else
+					return m_entries.data();
+			}
+
+		private:
+			std::array<name_index_entry, Size>	m_entries;
+		};
+
+		// Finds the first item named name which satisfies pred by binary search on the index.
+		// Falls back to linear search when the range has no index.
+		template<typename Iterator, typename Pred>
+		constexpr Iterator find_by_name(Iterator begin, Iterator end, const name_index_entry* index, std::string_view name, Pred&& pred)
+		{
+			if (index == nullptr)
+			{
+				return constexpr_find_if(begin, end, [name, &pred](const auto& i)
+					{
+						return name.compare(i.name()) == 0 && pred(i);
+					});
+			}
+
+			auto name_hash = hash(name);
+			size_t size = end - begin;
+			size_t lower = 0;
+			size_t upper = size;
+			while (lower < upper)
+			{
+				auto middle = lower + (upper - lower) / 2;
+				if (index[middle].hash < name_hash)
+					lower = middle + 1;
+				else
+					upper = middle;
+			}
+			for (; lower < size && index[lower].hash == name_hash; ++lower)
+			{
+				auto itr = begin + index[lower].position;
+				if (name.compare(itr->name()) == 0 && pred(*itr))
+					return itr;
+			}
+			return end;
+		}
+		template<typename Iterator>
+		constexpr Iterator find_by_name(Iterator begin, Iterator end, const name_index_entry* index, std::string_view name)
+		{
+			return find_by_name(begin, end, index, name, [](const auto&) { return true; });
+		}
+
 
 		template<
 			template<typename...> typename T,
@@ -251,6 +406,16 @@ namespace rtti
 		{};
 		template<typename T> constexpr bool has_runtime_type_v = has_runtime_type<T>::value;
 
+		// Address of the most derived object, which is the object get_type_view(object) describes.
+		template<typename T> void* get_object_address(T& object)
+		{
+			// has_runtime_type_v is also true for pointers to such classes, whose address is the pointer itself.
+			if constexpr (std::is_class_v<T> && has_runtime_type_v<T>)
+				return object.rtti_object_address();
+			else
+				return const_cast<std::remove_cv_t<T>*>(&object);
+		}
+
 		template<typename T> const type_view& get_type_view();
 		template<typename T> const type_view& get_type_view(T&& object)
 		{
@@ -283,37 +448,258 @@ namespace rtti
 		}
 
 		class value;
+		class value_ref;
 		template<typename T> const T* value_cast(const value&);
 		template<typename T> T* value_cast_object(const value&);
+		template<typename T> const T* value_cast(const value_ref&);
+		template<typename T> T* value_cast_object(const value_ref&);
+		inline void* upcast(void* object, const type_view& from_type, const type_view& to_type);
+		inline void* object_address(const value& object, const type_view& to_type, bool is_mutable);
+
+		inline std::pmr::memory_resource*& current_memory_resource()
+		{
+			thread_local std::pmr::memory_resource* resource = nullptr;
+			return resource;
+		}
+
+		// Returns the resource which rtti allocates from on this thread.
+		inline std::pmr::memory_resource* get_memory_resource()
+		{
+			auto resource = current_memory_resource();
+			return resource ? resource : std::pmr::get_default_resource();
+		}
+
+		// Routes rtti allocations of the current thread to the resource while alive.
+		// Objects from type_view::instantiate(args) are still allocated by new, as their callers own and delete them.
+		class memory_resource_scope : noncopyable
+		{
+		public:
+			memory_resource_scope(std::pmr::memory_resource& resource)
+				: m_previous(current_memory_resource())
+			{
+				current_memory_resource() = &resource;
+			}
+			~memory_resource_scope()
+			{
+				current_memory_resource() = m_previous;
+			}
+
+		private:
+			std::pmr::memory_resource*	m_previous;
+		};
+
+		// Bump allocator which releases everything at once by reset().
+		// Blocks are kept by reset() and reused by following allocations.
+		class arena_resource : public std::pmr::memory_resource, noncopyable
+		{
+		public:
+			static constexpr size_t default_block_size = 64 * 1024;
+
+			explicit arena_resource(size_t block_size = default_block_size, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+				: m_upstream(upstream)
+				, m_block_size(block_size)
+			{}
+			~arena_resource()
+			{
+				release();
+			}
+
+			// Rewinds to the first block. Destructors of objects in the arena are not called.
+			void reset()
+			{
+				m_current = m_head;
+				m_cursor = m_current ? m_current->begin() : nullptr;
+				m_used = 0;
+			}
+
+			// Returns all blocks to the upstream resource.
+			void release()
+			{
+				while (m_head)
+				{
+					auto next = m_head->next;
+					m_upstream->deallocate(m_head, m_head->size, alignof(block));
+					m_head = next;
+				}
+				m_current = nullptr;
+				m_cursor = nullptr;
+				m_used = 0;
+			}
+
+			size_t used() const { return m_used; }
+
+		private:
+			struct alignas(std::max_align_t) block
+			{
+				block*	next;
+				size_t	size;
+
+				char* begin() { return reinterpret_cast<char*>(this + 1); }
+				char* end() { return reinterpret_cast<char*>(this) + size; }
+			};
+
+			std::pmr::memory_resource*	m_upstream;
+			size_t						m_block_size;
+			block*						m_head = nullptr;
+			block*						m_current = nullptr;
+			char*						m_cursor = nullptr;
+			size_t						m_used = 0;
+
+			void* do_allocate(size_t bytes, size_t alignment) override
+			{
+				while (true)
+				{
+					if (m_current)
+					{
+						auto address = reinterpret_cast<uintptr_t>(m_cursor);
+						auto aligned = (address + alignment - 1) & ~(uintptr_t)(alignment - 1);
+						if (aligned + bytes <= reinterpret_cast<uintptr_t>(m_current->end()))
+						{
+							m_cursor = reinterpret_cast<char*>(aligned + bytes);
+							m_used += bytes;
+							return reinterpret_cast<void*>(aligned);
+						}
+					}
+					next_block(bytes + alignment);
+				}
+			}
+			void do_deallocate(void*, size_t, size_t) override
+			{}
+			bool do_is_equal(const std::pmr::memory_resource& r) const noexcept override
+			{
+				return this == &r;
+			}
+
+			void next_block(size_t required)
+			{
+				// Reuse blocks kept by reset() before asking upstream.
+				while (m_current && m_current->next)
+				{
+					m_current = m_current->next;
+					m_cursor = m_current->begin();
+					if ((size_t)(m_current->end() - m_cursor) >= required)
+						return;
+				}
+
+				auto size = sizeof(block) + (required > m_block_size ? required : m_block_size);
+				auto p = new(m_upstream->allocate(size, alignof(block))) block{ nullptr, size };
+				if (m_current)
+				{
+					p->next = m_current->next;
+					m_current->next = p;
+				}
+				else
+				{
+					p->next = m_head;
+					m_head = p;
+				}
+				m_current = p;
+				m_cursor = p->begin();
+			}
+		};
+
+		// Returns memory to its resource unless dismissed by clearing address, when the constructor of the object placed in it throws.
+		struct allocation_rollback
+		{
+			std::pmr::memory_resource*	resource = nullptr;
+			void*						address = nullptr;
+			size_t						size = 0;
+			size_t						alignment = 0;
+
+			~allocation_rollback()
+			{
+				if (address)
+					resource->deallocate(address, size, alignment);
+			}
+		};
 
+		struct value_ops
+		{
+			void(*destroy)(void*);
+			void(*move)(void* dst, void* src);
+			void(*copy)(void* dst, const void* src);	// null for move-only types
+			size_t size;
+			size_t alignment;
+			bool is_small;
+			bool is_trivial;
+		};
+
+		template<typename T>
+		inline constexpr value_ops value_ops_instance = {
+			[](void* p) { reinterpret_cast<T*>(p)->~T(); },
+			[](void* dst, void* src)
+			{
+				new(dst) T(std::move(*reinterpret_cast<T*>(src)));
+				reinterpret_cast<T*>(src)->~T();
+			},
+			[]() -> void(*)(void*, const void*)
+			{
+				if constexpr (std::is_copy_constructible_v<T>)
+					return [](void* dst, const void* src) { new(dst) T(*reinterpret_cast<const T*>(src)); };
+				else
+					return nullptr;
+			}(),
+			sizeof(T),
+			alignof(T),
+			sizeof(T) <= RTTI_VALUE_INLINE_CAPACITY && alignof(T) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<T>,
+			std::is_trivially_copyable_v<T>,
+		};
+
+		// Type erased object, held in an inline buffer or allocated from a memory_resource.
+		// A value which holds a move-only object can be moved but not copied. can_copy() tells it, and copy_from() reports it,
+		// while the copy constructor and assignment throw std::logic_error.
 		class value
 		{
+			friend class value_ref;
 			template<typename T> friend const T* value_cast(const value&);
 			template<typename T> friend T* value_cast_object(const value&);
+			template<typename T> using enable_if_not_value = std::enable_if_t<!std::is_same_v<std::decay_t<T>, value>>;
 		public:
+			static constexpr size_t inline_capacity = RTTI_VALUE_INLINE_CAPACITY;
+
 			value()
 			{}
-			value(value&& value)
-				: m_type(value.m_type)
-				, m_storage(value.m_storage)
+			value(value&& r)
+			{
+				take(r);
+			}
+			value(const value& r)
 			{
-				value.m_type = nullptr;
+				require_copy(r);
+				copy(r);
 			}
 			~value()
 			{
 				reset();
 			}
 
-			template<typename T>
+			template<typename T, typename = enable_if_not_value<T>>
 			value(T&& value) { assign(std::forward<T>(value)); }
 
-			template<typename T>
+			// Allocates from the resource when the object does not fit in the inline buffer.
+			template<typename T, typename = enable_if_not_value<T>>
+			value(std::allocator_arg_t, std::pmr::memory_resource* resource, T&& value) { assign(std::forward<T>(value), resource); }
+
+			template<typename T, typename = enable_if_not_value<T>>
 			value& operator=(T&& value) { assign(std::forward<T>(value)); return *this; }
-			value& operator=(value&& val) 
+			value& operator=(value&& r)
 			{
-				m_type = val.m_type;
-				m_storage = val.m_storage;
-				val.m_type = nullptr;
+				if (this != &r)
+				{
+					reset();
+					take(r);
+				}
+				return *this;
+			}
+			// Leaves this value unchanged when it throws.
+			value& operator=(const value& r)
+			{
+				if (this != &r)
+				{
+					require_copy(r);
+					reset();
+					copy(r);
+				}
 				return *this;
 			}
 
@@ -322,15 +708,42 @@ namespace rtti
 				if (m_type == nullptr)
 					return;
 
-				if (!m_storage.small.is_small)
+				if (m_ops->is_small)
+				{
+					if (!m_ops->is_trivial)
+						m_ops->destroy(m_storage.small);
+				}
+				else
 				{
-					m_storage.large->destructor(m_storage.large->buffer);
-					free(m_storage.large);
+					m_ops->destroy(m_storage.large.address);
+					m_storage.large.resource->deallocate(m_storage.large.address, m_ops->size, m_ops->alignment);
 				}
+				m_type = nullptr;
+				m_ops = nullptr;
 			}
 
 			bool has_value() const { return m_type; }
 
+			// Returns true when the held object lives in the inline buffer.
+			bool is_inline() const { return m_type && m_ops->is_small; }
+			// False when the held object is move-only, which copies of the value can not hold.
+			bool can_copy() const { return m_type == nullptr || m_ops->copy != nullptr; }
+			// Copies the object of r. Returns false and leaves this value unchanged when r holds a move-only object.
+			bool copy_from(const value& r)
+			{
+				if (!r.can_copy())
+					return false;
+				if (this != &r)
+				{
+					reset();
+					copy(r);
+				}
+				return true;
+			}
+
+			template<typename T>
+			static constexpr bool is_inline() { return value_ops_instance<std::decay_t<T>>.is_small; }
+
 			const type_view& type() const
 			{
 				if (m_type)
@@ -339,62 +752,188 @@ namespace rtti
 			}
 
 		private:
-			struct small_value
-			{
-				char buffer[sizeof(void*) + 15];
-				bool is_small : 1;
-			};
 			struct large_value
 			{
-				void(*destructor)(void*);
-				char buffer[1];
+				void*						address;
+				std::pmr::memory_resource*	resource;
 			};
 			union storage
 			{
-				small_value  small;
-				large_value* large;
+				alignas(std::max_align_t) char small[inline_capacity];
+				large_value large;
 			};
 
 			const type_view*	m_type = nullptr;
+			const value_ops*	m_ops = nullptr;
 			storage				m_storage;
 
 			template<typename T>
-			void assign(T&& v)
+			void assign(T&& v, std::pmr::memory_resource* resource = nullptr)
 			{
 				reset();
 
 				using value_type = std::decay_t<T>;
 				static_assert(!std::is_same_v<value_type, value>);
-				static_assert(std::is_copy_constructible_v<value_type>);
+				static_assert(std::is_move_constructible_v<value_type>);
 
-				constexpr size_t value_size = sizeof(value_type);
+				constexpr auto& ops = value_ops_instance<value_type>;
+
+				if constexpr (std::is_pointer_v<value_type> && has_runtime_type_v<value_type>)
+				{
+					// Keep the address consistent with the runtime type for a pointer to a base.
+					if (v != nullptr)
+					{
+						assign_pointer(get_type_view(v), get_object_address(*v));
+						return;
+					}
+				}
 
 				void* addr;
-				if constexpr (value_size <= sizeof(m_storage.small.buffer) && std::is_trivially_destructible_v<value_type>)
+				allocation_rollback allocated;
+				if constexpr (ops.is_small)
 				{
-					addr = m_storage.small.buffer;
-					m_storage.small.is_small = true;
+					addr = m_storage.small;
 				}
 				else
 				{
-					m_storage.large = reinterpret_cast<large_value*>(malloc(value_size + sizeof(large_value)));
-					m_storage.large->destructor = [](void* p) {
-						reinterpret_cast<value_type*>(p)->~value_type();
-					};
-					addr = m_storage.large->buffer;
-					m_storage.small.is_small = false;
+					allocated.resource = resource ? resource : get_memory_resource();
+					allocated.address = addr = allocate(ops, allocated.resource);
+					allocated.size = ops.size;
+					allocated.alignment = ops.alignment;
 				}
 
 				m_type = &get_type_view(*(new(addr) value_type(std::forward<T>(v))));
+				m_ops = &ops;
+				allocated.address = nullptr;
+			}
+
+			void take(value& r)
+			{
+				if (r.m_type == nullptr)
+					return;
+
+				if (!r.m_ops->is_small)
+					m_storage.large = r.m_storage.large;
+				else if (r.m_ops->is_trivial)
+					m_storage = r.m_storage;
+				else
+					r.m_ops->move(m_storage.small, r.m_storage.small);
+
+				m_type = r.m_type;
+				m_ops = r.m_ops;
+				r.m_type = nullptr;
+				r.m_ops = nullptr;
+			}
+
+			// Copying a move-only object is an error, which is thrown rather than leaving an empty copy.
+			static void require_copy(const value& r)
+			{
+				if (!r.can_copy())
+					throw std::logic_error("a value holding a move-only object can not be copied");
+			}
+
+			void copy(const value& r)
+			{
+				if (r.m_type == nullptr)
+					return;
+
+				if (!r.m_ops->is_small)
+				{
+					auto resource = get_memory_resource();
+					allocation_rollback allocated = { resource, allocate(*r.m_ops, resource), r.m_ops->size, r.m_ops->alignment };
+					r.m_ops->copy(allocated.address, r.m_storage.large.address);
+					allocated.address = nullptr;
+				}
+				else if (r.m_ops->is_trivial)
+					m_storage = r.m_storage;
+				else
+					r.m_ops->copy(m_storage.small, r.m_storage.small);
+
+				m_type = r.m_type;
+				m_ops = r.m_ops;
 			}
 
 			void* buffer_address() const
 			{
-				return m_storage.small.is_small ? const_cast<char*>(m_storage.small.buffer) : m_storage.large->buffer;
+				return m_ops->is_small ? const_cast<char*>(m_storage.small) : m_storage.large.address;
+			}
+
+			void* allocate(const value_ops& ops, std::pmr::memory_resource* resource)
+			{
+				m_storage.large.address = resource->allocate(ops.size, ops.alignment);
+				m_storage.large.resource = resource;
+				return m_storage.large.address;
+			}
+
+			void assign_pointer(const type_view& pointer_type, const void* address)
+			{
+				reset();
+				new(m_storage.small) const void*(address);
+				m_type = &pointer_type;
+				m_ops = &value_ops_instance<const void*>;
+			}
+		};
+
+		// Non-owning reference to an object and its type.
+		// The referred object must outlive the reference.
+		class value_ref
+		{
+			template<typename T> friend const T* value_cast(const value_ref&);
+			template<typename T> friend T* value_cast_object(const value_ref&);
+			template<typename T> using enable_if_not_value = std::enable_if_t<
+				!std::is_same_v<std::remove_const_t<T>, value> && !std::is_same_v<std::remove_const_t<T>, value_ref>>;
+		public:
+			value_ref()
+			{}
+			value_ref(const type_view& type, void* address)
+				: m_type(&type)
+				, m_address(address)
+			{}
+			value_ref(const type_view& type, const void* address)
+				: m_type(&type)
+				, m_address(const_cast<void*>(address))
+				, m_is_const(true)
+			{}
+			value_ref(const value& v)
+				: m_type(v.m_type)
+				, m_address(v.m_type ? v.buffer_address() : nullptr)
+				, m_is_const(true)
+			{}
+			template<typename T, typename = enable_if_not_value<T>>
+			value_ref(T& object)
+				: m_type(&referred_type(object))
+				, m_address(get_object_address(object))
+				, m_is_const(std::is_const_v<T>)
+			{}
+
+			bool has_value() const { return m_type; }
+			bool is_const() const { return m_is_const; }
+			const void* address() const { return m_address; }
+			inline const type_view& type() const;
+
+			// Returns a value which holds the pointer to the referred object.
+			inline value pointer() const;
+
+		private:
+			const type_view*	m_type = nullptr;
+			void*				m_address = nullptr;
+			bool				m_is_const = false;
+
+			// A pointer is referred with its static type. The runtime type of the pointee would not match the address
+			// the pointer holds, which may be of a base subobject, and the pointer can not be adjusted in place.
+			template<typename T>
+			static const type_view& referred_type(T& object)
+			{
+				if constexpr (std::is_pointer_v<T>)
+					return get_type_view<std::remove_cv_t<T>>();
+				else
+					return get_type_view(object);
 			}
 		};
 
 		using arguments = const std::initializer_list<value>&;
+		// Signature id of the types which the arguments hold.
+		inline type_id_t get_signature_id(arguments args);
 
 		class attribute
 		{};
@@ -506,11 +1045,21 @@ namespace rtti
 			}
 		};
 
+		// Indices of an array element, or the leading indices of a sub-array.
+		// Holds up to capacity ranks inline, without virtual calls.
 		class index_base
 		{
 		public:
-			virtual size_t operator[](size_t rank) const = 0;
-			virtual size_t get_rank() const = 0;
+			static constexpr size_t capacity = 8;
+
+			constexpr size_t operator[](size_t i) const
+			{
+				return i < m_rank ? m_index[i] : 0;
+			}
+			constexpr size_t get_rank() const
+			{
+				return m_rank;
+			}
 
 			template<typename Tuple>
 			Tuple make_tuple() const
@@ -524,43 +1073,33 @@ namespace rtti
 			{
 				return Tuple{ (*this)[Indices]... };
 			}
-		};
-
-		template<typename ...Types>
-		class index : public index_base
-		{
-		public:
-			static constexpr size_t rank = sizeof...(Types);
 
-			index(Types... args)
-				: m_index{ ((size_t)args)... }
+		protected:
+			constexpr index_base()
+				: m_index{}
 			{}
-
-			virtual size_t operator[](size_t i) const override
-			{
-				return i < rank ? m_index[i] : 0;
-			}
-			virtual size_t get_rank() const override
+			template<typename... Types>
+			constexpr index_base(Types... args)
+				: m_index{ ((size_t)args)... }
+				, m_rank(sizeof...(Types))
 			{
-				return rank;
+				static_assert(sizeof...(Types) <= capacity);
 			}
 
 		private:
-			std::array<size_t, rank>	m_index;
+			std::array<size_t, capacity>	m_index;
+			size_t							m_rank = 0;
 		};
-		template<>
-		class index<> : public index_base
+
+		template<typename ...Types>
+		class index : public index_base
 		{
 		public:
-			static constexpr size_t rank = 0;
-			virtual size_t operator[](size_t i) const override
-			{
-				return 0;
-			}
-			virtual size_t get_rank() const override
-			{
-				return rank;
-			}
+			static constexpr size_t rank = sizeof...(Types);
+
+			constexpr index(Types... args)
+				: index_base(args...)
+			{}
 		};
 
 		template<size_t Ranks, typename... Types>
@@ -574,18 +1113,115 @@ namespace rtti
 		};
 		template<size_t Ranks> using index_tuple_t = typename index_tuple<Ranks>::type;
 
-		template<typename T = void, typename Value = int, size_t Ranks = 0>
-		struct property_invoker
+		// Byte offset of a data member, taken on probe storage without constructing Class.
+		template<typename Class, typename Value>
+		ptrdiff_t member_offset(Value(Class::* member))
 		{
-			using index_type = index_tuple_t<Ranks>;
-			using value_type = Value;
-			using object_type = T;
+			alignas(Class) unsigned char probe[sizeof(Class)];
+			auto object = reinterpret_cast<const Class*>(probe);
+			return reinterpret_cast<const unsigned char*>(&(object->*member)) - probe;
+		}
 
-			value_type get(const object_type* object, const index_type& index) const { return {}; }
-			void set(object_type* object, const value_type& value, const index_type& index) const {}
-			value_type* ref(object_type* object, const index_type& index) const { return {}; }
-			const value_type* cref(const object_type* object, const index_type& index) const { return {}; }
-			bool is_read_only() const { return false; }
+		// Memory layout of a property value inside its object.
+		struct property_layout
+		{
+			// Byte offset of the first element in the object, or -1 when the value is not a plain member.
+			ptrdiff_t	offset = -1;
+			size_t		element_size = 0;
+			size_t		element_alignment = 0;
+			// Array extents from the outermost, elements are stored contiguously in row-major order.
+			iterator_range<const size_t*>	extents;
+			bool		is_trivially_copyable = false;
+
+			constexpr bool is_addressable() const { return offset >= 0; }
+			constexpr size_t rank() const { return extents.size(); }
+			constexpr size_t count() const
+			{
+				size_t result = 1;
+				for (auto extent : extents)
+					result *= extent;
+				return result;
+			}
+			constexpr size_t size() const { return element_size * count(); }
+		};
+
+		template<typename Value, typename = std::make_index_sequence<std::rank_v<Value>>>
+		struct array_extents;
+		template<typename Value, size_t... Ranks>
+		struct array_extents<Value, std::index_sequence<Ranks...>>
+		{
+			static constexpr std::array<size_t, sizeof...(Ranks)> value = { std::extent_v<Value, Ranks>... };
+
+			static constexpr iterator_range<const size_t*> range()
+			{
+				if constexpr (sizeof...(Ranks) == 0)
+					return {};
+				else
+					return { value.data(), value.data() + value.size() };
+			}
+		};
+
+		// Finds the sub-array of Value selected by the leading indices, as the first element and the element count.
+		template<typename Value>
+		constexpr bool locate_slice(const index_base& index, size_t& begin, size_t& size)
+		{
+			constexpr size_t rank = std::rank_v<Value>;
+			constexpr auto& extents = array_extents<Value>::value;
+			if (index.get_rank() > rank)
+				return false;
+
+			begin = 0;
+			size = 1;
+			for (size_t i = 0; i < rank; ++i)
+			{
+				if (i < index.get_rank())
+				{
+					if (index[i] >= extents[i])
+						return false;
+					begin = begin * extents[i] + index[i];
+				}
+				else
+				{
+					begin *= extents[i];
+					size *= extents[i];
+				}
+			}
+			return true;
+		}
+
+		template<typename T>
+		void copy_elements(const T* source, size_t count, T* destination)
+		{
+			if constexpr (std::is_trivially_copyable_v<T>)
+				std::memcpy(destination, source, sizeof(T) * count);
+			else
+				std::copy_n(source, count, destination);
+		}
+
+		template<typename Value>
+		constexpr property_layout make_property_layout(ptrdiff_t offset)
+		{
+			using element_type = std::remove_cv_t<std::remove_all_extents_t<Value>>;
+			return { offset, sizeof(element_type), alignof(element_type), array_extents<Value>::range(), std::is_trivially_copyable_v<element_type> };
+		}
+
+		template<typename T = void, typename Value = int, size_t Ranks = 0>
+		struct property_invoker
+		{
+			using index_type = index_tuple_t<Ranks>;
+			using value_type = Value;
+			using object_type = T;
+
+			value_type get(const object_type* object, const index_type& index) const { return {}; }
+			bool set(object_type* object, const value_type& value, const index_type& index) const { return false; }
+			bool set(object_type* object, value_type&& value, const index_type& index) const { return false; }
+			value_type* ref(object_type* object, const index_type& index) const { return {}; }
+			const value_type* cref(const object_type* object, const index_type& index) const { return {}; }
+			bool is_read_only() const { return false; }
+			static constexpr bool is_referable() { return false; }
+			property_layout layout() const { return make_property_layout<value_type>(-1); }
+			size_t read_slice(const object_type* object, const index_base& index, value_type* values, size_t count) const { return 0; }
+			size_t write_slice(object_type* object, const index_base& index, const value_type* values, size_t count) const { return 0; }
 		};
 
 		template<typename Class, typename Value, typename BaseClass = property_invoker<Class, std::remove_cv_t<Value>>>
@@ -604,12 +1240,26 @@ namespace rtti
 			{
 				return object->*m_member;
 			}
-			void set(object_type* object, const value_type& value, const index_type& index) const
+			// Returns false when Value can not be assigned from the argument, as a move-only Value from a const reference.
+			bool set(object_type* object, const value_type& value, const index_type& index) const
 			{
-				if constexpr (!is_read_only())
+				if constexpr (std::is_copy_assignable_v<Value>)
 				{
 					(object->*m_member) = value;
+					return true;
+				}
+				else
+					return false;
+			}
+			bool set(object_type* object, value_type&& value, const index_type& index) const
+			{
+				if constexpr (std::is_move_assignable_v<Value>)
+				{
+					(object->*m_member) = std::move(value);
+					return true;
 				}
+				else
+					return false;
 			}
 			value_type* ref(object_type* object, const index_type& index) const
 			{
@@ -619,7 +1269,33 @@ namespace rtti
 			{
 				return &(object->*m_member);
 			}
-			static constexpr bool is_read_only() { return !std::is_copy_assignable_v<Value>; }
+			static constexpr bool is_read_only() { return !std::is_copy_assignable_v<Value> && !std::is_move_assignable_v<Value>; }
+			static constexpr bool is_referable() { return true; }
+			property_layout layout() const { return make_property_layout<Value>(member_offset(m_member)); }
+			size_t read_slice(const object_type* object, const index_base& index, value_type* values, size_t count) const
+			{
+				if constexpr (std::is_copy_assignable_v<value_type>)
+				{
+					if (index.get_rank() == 0 && count >= 1)
+					{
+						*values = object->*m_member;
+						return 1;
+					}
+				}
+				return 0;
+			}
+			size_t write_slice(object_type* object, const index_base& index, const value_type* values, size_t count) const
+			{
+				if constexpr (std::is_copy_assignable_v<Value>)
+				{
+					if (index.get_rank() == 0 && count >= 1)
+					{
+						object->*m_member = *values;
+						return 1;
+					}
+				}
+				return 0;
+			}
 		};
 
 		template<typename Class, typename Value, typename BaseClass = property_invoker<Class, std::remove_cv_t<std::remove_all_extents_t<Value>>, std::rank_v<Value>>>
@@ -657,12 +1333,25 @@ namespace rtti
 				else
 					return set<Rank + 1>(valueArray[std::get<Rank>(index)], index);
 			}
-			void set(object_type* object, const value_type& value, const index_type& index) const
+			bool set(object_type* object, const value_type& value, const index_type& index) const
 			{
-				if constexpr (!is_read_only())
+				if constexpr (std::is_copy_assignable_v<std::remove_all_extents_t<Value>>)
 				{
 					set<0>(object->*m_member, index) = value;
+					return true;
+				}
+				else
+					return false;
+			}
+			bool set(object_type* object, value_type&& value, const index_type& index) const
+			{
+				if constexpr (std::is_move_assignable_v<std::remove_all_extents_t<Value>>)
+				{
+					set<0>(object->*m_member, index) = std::move(value);
+					return true;
 				}
+				else
+					return false;
 			}
 
 			value_type* ref(object_type* object, const index_type& index) const
@@ -674,7 +1363,37 @@ namespace rtti
 				return &get<0>(object->*m_member, index);
 			}
 
-			static constexpr bool is_read_only() { return !std::is_copy_assignable_v<std::remove_all_extents_t<Value>>; }
+			static constexpr bool is_read_only() { return !std::is_copy_assignable_v<std::remove_all_extents_t<Value>> && !std::is_move_assignable_v<std::remove_all_extents_t<Value>>; }
+			static constexpr bool is_referable() { return true; }
+			property_layout layout() const { return make_property_layout<Value>(member_offset(m_member)); }
+
+			// Copies a row, a plane or the whole array in one call.
+			size_t read_slice(const object_type* object, const index_base& index, value_type* values, size_t count) const
+			{
+				if constexpr (std::is_copy_assignable_v<value_type>)
+				{
+					size_t begin, size;
+					if (locate_slice<Value>(index, begin, size) && size <= count)
+					{
+						copy_elements(reinterpret_cast<const value_type*>(&(object->*m_member)) + begin, size, values);
+						return size;
+					}
+				}
+				return 0;
+			}
+			size_t write_slice(object_type* object, const index_base& index, const value_type* values, size_t count) const
+			{
+				if constexpr (std::is_copy_assignable_v<std::remove_all_extents_t<Value>>)
+				{
+					size_t begin, size;
+					if (locate_slice<Value>(index, begin, size) && size <= count)
+					{
+						copy_elements(values, size, reinterpret_cast<value_type*>(&(object->*m_member)) + begin);
+						return size;
+					}
+				}
+				return 0;
+			}
 		};
 
 		template<typename Class, typename Value, typename BaseClass = property_invoker<Class, Value>>
@@ -697,10 +1416,12 @@ namespace rtti
 			{
 				return (object->*m_getter)();
 			}
-			void set(object_type* object, const value_type& value, const index_type& index) const
+			bool set(object_type* object, const value_type& value, const index_type& index) const
 			{
-				if (!is_read_only())
-					(object->*m_setter)(value);
+				if (is_read_only())
+					return false;
+				(object->*m_setter)(value);
+				return true;
 			}
 
 			constexpr bool is_read_only() const { return m_setter == nullptr; }
@@ -726,15 +1447,159 @@ namespace rtti
 			{
 				return m_getter(*object);
 			}
-			void set(object_type* object, const value_type& value, const index_type& index) const
+			bool set(object_type* object, const value_type& value, const index_type& index) const
 			{
-				if (!is_read_only())
-					m_setter(*object, value);
+				if (is_read_only())
+					return false;
+				m_setter(*object, value);
+				return true;
 			}
 
 			constexpr bool is_read_only() const { return m_setter == nullptr; }
 		};
 
+		// Accessor methods returning a reference, which lets ref/cref reach the value without copying.
+		template<typename Class, typename Value, typename BaseClass = property_invoker<Class, Value>>
+		struct property_method_ref_invoker : public BaseClass
+		{
+			using index_type = typename BaseClass::index_type;
+			using value_type = typename BaseClass::value_type;
+			using object_type = typename BaseClass::object_type;
+			using getter_type = const Value&(Class::*)() const;
+			using accessor_type = Value&(Class::*)();
+			using setter_type = void(Class::*)(const Value&);
+			getter_type		m_getter;
+			accessor_type	m_accessor;
+			setter_type		m_setter;
+
+			constexpr property_method_ref_invoker(getter_type getter, accessor_type accessor, setter_type setter)
+				: m_getter(getter)
+				, m_accessor(accessor)
+				, m_setter(setter)
+			{}
+
+			value_type get(const object_type* object, const index_type& index) const
+			{
+				return (object->*m_getter)();
+			}
+			// Both overloads go through the setter when one is given, so its side effects do not depend on the argument.
+			bool set(object_type* object, const value_type& value, const index_type& index) const
+			{
+				if (m_setter)
+				{
+					(object->*m_setter)(value);
+					return true;
+				}
+				if constexpr (std::is_copy_assignable_v<value_type>)
+				{
+					if (m_accessor)
+					{
+						(object->*m_accessor)() = value;
+						return true;
+					}
+				}
+				return false;
+			}
+			bool set(object_type* object, value_type&& value, const index_type& index) const
+			{
+				if (m_setter)
+				{
+					(object->*m_setter)(value);
+					return true;
+				}
+				if constexpr (std::is_move_assignable_v<value_type>)
+				{
+					if (m_accessor)
+					{
+						(object->*m_accessor)() = std::move(value);
+						return true;
+					}
+				}
+				return false;
+			}
+			value_type* ref(object_type* object, const index_type& index) const
+			{
+				return m_accessor ? &(object->*m_accessor)() : nullptr;
+			}
+			const value_type* cref(const object_type* object, const index_type& index) const
+			{
+				return &(object->*m_getter)();
+			}
+
+			constexpr bool is_read_only() const { return m_setter == nullptr && m_accessor == nullptr; }
+			static constexpr bool is_referable() { return true; }
+		};
+
+		template<typename Class, typename Value, class BaseClass = property_invoker<Class, Value>>
+		struct property_delegate_ref_invoker : public BaseClass
+		{
+			using index_type = typename BaseClass::index_type;
+			using value_type = typename BaseClass::value_type;
+			using object_type = typename BaseClass::object_type;
+			using getter_type = const Value&(*)(const Class&);
+			using accessor_type = Value&(*)(Class&);
+			using setter_type = void(*)(Class&, const Value&);
+			getter_type		m_getter;
+			accessor_type	m_accessor;
+			setter_type		m_setter;
+
+			constexpr property_delegate_ref_invoker(getter_type getter, accessor_type accessor, setter_type setter)
+				: m_getter(getter)
+				, m_accessor(accessor)
+				, m_setter(setter)
+			{}
+
+			value_type get(const object_type* object, const index_type& index) const
+			{
+				return m_getter(*object);
+			}
+			bool set(object_type* object, const value_type& value, const index_type& index) const
+			{
+				if (m_setter)
+				{
+					m_setter(*object, value);
+					return true;
+				}
+				if constexpr (std::is_copy_assignable_v<value_type>)
+				{
+					if (m_accessor)
+					{
+						m_accessor(*object) = value;
+						return true;
+					}
+				}
+				return false;
+			}
+			bool set(object_type* object, value_type&& value, const index_type& index) const
+			{
+				if (m_setter)
+				{
+					m_setter(*object, value);
+					return true;
+				}
+				if constexpr (std::is_move_assignable_v<value_type>)
+				{
+					if (m_accessor)
+					{
+						m_accessor(*object) = std::move(value);
+						return true;
+					}
+				}
+				return false;
+			}
+			value_type* ref(object_type* object, const index_type& index) const
+			{
+				return m_accessor ? &m_accessor(*object) : nullptr;
+			}
+			const value_type* cref(const object_type* object, const index_type& index) const
+			{
+				return &m_getter(*object);
+			}
+
+			constexpr bool is_read_only() const { return m_setter == nullptr && m_accessor == nullptr; }
+			static constexpr bool is_referable() { return true; }
+		};
+
 		template<typename Type = void, typename Invoker = property_invoker<>, typename Attributes = type_list< >>
 		class property
 		{
@@ -765,6 +1630,21 @@ namespace rtti
 				return property<Value, decltype(invoker), Attributes>(m_name, m_display_name, m_attributes, invoker);
 			}
 			template<typename Class, typename Value>
+			constexpr auto member(const Value&(Class::* getter)() const) const
+			{
+				return member_ref(property_method_ref_invoker<Class, Value>{ getter, nullptr, nullptr });
+			}
+			template<typename Class, typename Value>
+			constexpr auto member(const Value&(Class::* getter)() const, void(Class::* setter)(const Value&)) const
+			{
+				return member_ref(property_method_ref_invoker<Class, Value>{ getter, nullptr, setter });
+			}
+			template<typename Class, typename Value>
+			constexpr auto member(const Value&(Class::* getter)() const, Value&(Class::* accessor)()) const
+			{
+				return member_ref(property_method_ref_invoker<Class, Value>{ getter, accessor, nullptr });
+			}
+			template<typename Class, typename Value>
 			constexpr auto member(Value(Class::* p)) const
 			{
 				if constexpr (std::is_array_v<Value>)
@@ -784,6 +1664,21 @@ namespace rtti
 				auto invoker = property_delegate_invoker<Class, Value>{ getter, nullptr };
 				return property<Value, decltype(invoker), Attributes>(m_name, m_display_name, m_attributes, invoker);
 			}
+			template<typename Class, typename Value>
+			constexpr auto delegate(const Value&(*getter)(const Class&)) const
+			{
+				return member_ref(property_delegate_ref_invoker<Class, Value>{ getter, nullptr, nullptr });
+			}
+			template<typename Class, typename Value>
+			constexpr auto delegate(const Value&(*getter)(const Class&), void(*setter)(Class&, const Value&)) const
+			{
+				return member_ref(property_delegate_ref_invoker<Class, Value>{ getter, nullptr, setter });
+			}
+			template<typename Class, typename Value>
+			constexpr auto delegate(const Value&(*getter)(const Class&), Value&(*accessor)(Class&)) const
+			{
+				return member_ref(property_delegate_ref_invoker<Class, Value>{ getter, accessor, nullptr });
+			}
 
 			constexpr auto display_name(std::string_view name) const
 			{
@@ -799,9 +1694,13 @@ namespace rtti
 			{
 				return m_invoker.get(object, idx);
 			}
-			void set(object_type* object, const value_type& value, const index_type& idx = {}) const
+			bool set(object_type* object, const value_type& value, const index_type& idx = {}) const
+			{
+				return m_invoker.set(object, value, idx);
+			}
+			bool set(object_type* object, value_type&& value, const index_type& idx = {}) const
 			{
-				m_invoker.set(object, value, idx);
+				return m_invoker.set(object, std::move(value), idx);
 			}
 			value_type* ref(object_type* object, const index_type& idx = {}) const
 			{
@@ -815,7 +1714,17 @@ namespace rtti
 			constexpr std::string_view name() const { return m_name; }
 			constexpr std::string_view display_name() const { return m_display_name; }
 			constexpr bool is_read_only() const { return m_invoker.is_read_only(); }
+			static constexpr bool is_referable() { return Invoker::is_referable(); }
 			constexpr const attribute_set& attributes() const { return m_attributes; }
+			property_layout layout() const { return m_invoker.layout(); }
+			size_t read_slice(const object_type* object, const index_base& idx, value_type* values, size_t count) const
+			{
+				return m_invoker.read_slice(object, idx, values, count);
+			}
+			size_t write_slice(object_type* object, const index_base& idx, const value_type* values, size_t count) const
+			{
+				return m_invoker.write_slice(object, idx, values, count);
+			}
 
 		protected:
 			std::string_view		m_name;
@@ -832,6 +1741,12 @@ namespace rtti
 				return property<value_t, decltype(invoker), Attributes>(m_name, m_display_name, m_attributes, invoker);
 			}
 
+			template<typename RefInvoker>
+			constexpr auto member_ref(const RefInvoker& invoker) const
+			{
+				return property<typename RefInvoker::value_type, RefInvoker, Attributes>(m_name, m_display_name, m_attributes, invoker);
+			}
+
 			template<typename Class, typename Value>
 			constexpr auto member_scalar(Value(Class::* pmember)) const
 			{
@@ -851,17 +1766,32 @@ namespace rtti
 				, m_attributes(instance.attributes().iterable())
 				, m_getter([](const void* instance, const value& object, const index_base& index) -> value
 					{ 
-						if (auto p = value_cast_object<const typename T::object_type>(object))
-							return reinterpret_cast<const T*>(instance)->get(p, index.make_tuple<typename T::index_type>());
+						// A move-only property cannot be copied out; use view() or ref() instead.
+						if constexpr (std::is_copy_constructible_v<typename T::value_type>)
+						{
+							if (auto p = value_cast_object<const typename T::object_type>(object))
+								return reinterpret_cast<const T*>(instance)->get(p, index.make_tuple<typename T::index_type>());
+						}
 						return {};
 					})
-				, m_setter([](const void* instance, const value& object, const value& value, const index_base& index)
+				, m_setter([](const void* instance, const value& object, const value& value, const index_base& index) -> bool
 					{ 
 						if (auto p = value_cast_object<typename T::object_type>(object))
 						{
 							if (auto v = value_cast<typename T::value_type>(value))
-								reinterpret_cast<const T*>(instance)->set(p, *v, index.make_tuple<typename T::index_type>());
+								return reinterpret_cast<const T*>(instance)->set(p, *v, index.make_tuple<typename T::index_type>());
+						}
+						return false;
+					})
+				, m_mover([](const void* instance, const value& object, value& value, const index_base& index) -> bool
+					{ 
+						if (auto p = value_cast_object<typename T::object_type>(object))
+						{
+							// The value is owned by the caller as an rvalue, so its content may be moved from.
+							if (auto v = const_cast<typename T::value_type*>(value_cast<typename T::value_type>(value)))
+								return reinterpret_cast<const T*>(instance)->set(p, std::move(*v), index.make_tuple<typename T::index_type>());
 						}
+						return false;
 					})
 				, m_refer([](const void* instance, const value& object, const index_base& index) -> value
 					{ 
@@ -875,7 +1805,53 @@ namespace rtti
 							return reinterpret_cast<const T*>(instance)->cref(p, index.make_tuple<typename T::index_type>());
 						return {};
 					})
+				, m_viewer([](const void* instance, const value& object, const index_base& index) -> value_ref
+					{
+						if (auto p = value_cast_object<typename T::object_type>(object))
+						{
+							if (auto r = reinterpret_cast<const T*>(instance)->ref(p, index.make_tuple<typename T::index_type>()))
+								return *r;
+						}
+						// A property exposed by a const getter only is viewed as const.
+						if (auto p = value_cast_object<const typename T::object_type>(object))
+						{
+							if (auto r = reinterpret_cast<const T*>(instance)->cref(p, index.make_tuple<typename T::index_type>()))
+								return *r;
+						}
+						return {};
+					})
+				, m_reader([](const void* instance, const void* object, void* value)
+					{
+						if constexpr (std::is_copy_constructible_v<typename T::value_type> && std::is_copy_assignable_v<typename T::value_type>)
+						{
+							*static_cast<typename T::value_type*>(value) = reinterpret_cast<const T*>(instance)->get(static_cast<const typename T::object_type*>(object));
+							return true;
+						}
+						else
+							return false;
+					})
+				, m_writer([](const void* instance, void* object, const void* value) -> bool
+					{
+						return reinterpret_cast<const T*>(instance)->set(static_cast<typename T::object_type*>(object), *static_cast<const typename T::value_type*>(value));
+					})
+				, m_layout([](const void* instance) { return reinterpret_cast<const T*>(instance)->layout(); })
+				, m_slice_reader([](const void* instance, const value& object, const index_base& index, void* values, size_t count) -> size_t
+					{
+						if (auto p = value_cast_object<const typename T::object_type>(object))
+							return reinterpret_cast<const T*>(instance)->read_slice(p, index, static_cast<typename T::value_type*>(values), count);
+						return 0;
+					})
+				, m_slice_writer([](const void* instance, const value& object, const index_base& index, const void* values, size_t count) -> size_t
+					{
+						if (auto p = value_cast_object<typename T::object_type>(object))
+							return reinterpret_cast<const T*>(instance)->write_slice(p, index, static_cast<const typename T::value_type*>(values), count);
+						return 0;
+					})
 				, m_view_getter(get_type_view<typename T::value_type>)
+				, m_object_view_getter(get_type_view<typename T::object_type>)
+				, m_rank(std::tuple_size_v<typename T::index_type>)
+				, m_is_read_only(instance.is_read_only())
+				, m_is_referable(instance.is_referable())
 			{
 			}
 
@@ -886,9 +1862,16 @@ namespace rtti
 			{
 				return m_getter(m_instance, object, idx);
 			}
-			void set(const value& object, const value& value, const index_base& idx = index<>()) const
+			// Returns false when nothing is written: object or value has another type, the property is read only,
+			// or value_type() is move-only and can be set only from an rvalue.
+			bool set(const value& object, const value& value, const index_base& idx = index<>()) const
+			{
+				return m_setter(m_instance, object, value, idx);
+			}
+			// Moves the content of value into the property. Required for move-only value types.
+			bool set(const value& object, value&& value, const index_base& idx = index<>()) const
 			{
-				m_setter(m_instance, object, value, idx);
+				return m_mover(m_instance, object, value, idx);
 			}
 			value ref(const value& object, const index_base& idx = index<>()) const
 			{
@@ -898,18 +1881,195 @@ namespace rtti
 			{
 				return m_crefer(m_instance, object, idx);
 			}
-			inline const type_view& value_type() const;
-
-		private:
-			const void* m_instance;
-			std::string_view		m_name;
-			std::string_view		m_display_name;
-			attribute_iterable		m_attributes;
-			value(*m_getter)(const void*, const value&, const index_base&);
-			void(*m_setter)(const void*, const value&, const value&, const index_base&);
-			value(*m_refer)(const void*, const value&, const index_base&);
+			// Refers the property of the object without copying it.
+			// Returns an empty reference when the property is not addressable.
+			value_ref view(const value& object, const index_base& idx = index<>()) const
+			{
+				return m_viewer(m_instance, object, idx);
+			}
+			// Reads the value without boxing. object must point to object_type(), value to value_type().
+			// Returns false and leaves value unchanged when value_type() can not be copy assigned.
+			bool read(const void* object, void* value) const
+			{
+				return m_reader(m_instance, object, value);
+			}
+			// Writes the value without boxing. object must point to object_type(), value to value_type().
+			// Returns false when nothing is written, as value_type() can not be copy assigned or the property is read only.
+			bool write(void* object, const void* value) const
+			{
+				return m_writer(m_instance, object, value);
+			}
+			// Copies the sub-array selected by the leading indices of idx into values, which has room for count elements.
+			// Returns the number of elements copied, or 0 when V is not value_type() or the slice is not available.
+			template<typename V>
+			size_t read_slice(const value& object, const index_base& idx, V* values, size_t count) const
+			{
+				if (value_type() != get_type_view<V>())
+					return 0;
+				return m_slice_reader(m_instance, object, idx, values, count);
+			}
+			// Copies values into the sub-array selected by the leading indices of idx.
+			template<typename V>
+			size_t write_slice(const value& object, const index_base& idx, const V* values, size_t count) const
+			{
+				if (value_type() != get_type_view<V>())
+					return 0;
+				return m_slice_writer(m_instance, object, idx, values, count);
+			}
+			// Where the value is placed in object_type(), for copying it without the accessors.
+			property_layout layout() const { return m_layout(m_instance); }
+			ptrdiff_t offset() const { return layout().offset; }
+			constexpr size_t rank() const { return m_rank; }
+			constexpr bool is_read_only() const { return m_is_read_only; }
+			// True when view(), cref() and, unless only a const getter is given, ref() refer to the value in place.
+			// Unlike property_layout::is_addressable(), the value may be reached through accessors which return references.
+			constexpr bool is_referable() const { return m_is_referable; }
+			inline const type_view& value_type() const;
+			inline const type_view& object_type() const;
+
+			// Reads the property of count objects into values, checking the types once.
+			// Returns false when V is not value_type(), V can not be read without boxing, or an object is not an object_type().
+			template<typename V>
+			bool get_many(const value* objects, size_t count, V* values) const
+			{
+				auto& type = object_type();
+				return get_many_impl(count, values, [&](size_t i) -> const void* { return object_address(objects[i], type, false); });
+			}
+			// objects are addresses of object_type().
+			template<typename V>
+			bool get_many(const void* const* objects, size_t count, V* values) const
+			{
+				return get_many_impl(count, values, [&](size_t i) { return objects[i]; });
+			}
+			// Reads from an array of T.
+			template<typename T, typename V, typename = std::enable_if_t<std::is_class_v<T> && !std::is_same_v<T, value>>>
+			bool get_many(const T* objects, size_t count, V* values) const
+			{
+				auto offset = array_offset(objects, count);
+				if (offset < 0)
+					return count == 0;
+				return get_many_impl(count, values, [&](size_t i) { return reinterpret_cast<const char*>(objects + i) + offset; });
+			}
+
+			// Writes values to the property of count objects, checking the types once.
+			// Returns false when V is not value_type(), the property is read only, V can not be written without boxing,
+			// or an object is not a mutable object_type().
+			template<typename V>
+			bool set_many(const value* objects, size_t count, const V* values) const
+			{
+				auto& type = object_type();
+				return set_many_impl(count, values, [&](size_t i) { return object_address(objects[i], type, true); });
+			}
+			// objects are addresses of object_type().
+			template<typename V>
+			bool set_many(void* const* objects, size_t count, const V* values) const
+			{
+				return set_many_impl(count, values, [&](size_t i) { return objects[i]; });
+			}
+			// Writes to an array of T.
+			template<typename T, typename V, typename = std::enable_if_t<std::is_class_v<T> && !std::is_same_v<T, value>>>
+			bool set_many(T* objects, size_t count, const V* values) const
+			{
+				auto offset = array_offset(objects, count);
+				if (offset < 0)
+					return count == 0;
+				return set_many_impl(count, values, [&](size_t i) { return reinterpret_cast<char*>(objects + i) + offset; });
+			}
+
+		private:
+			// Offset of object_type() in each element of an array of T, or -1.
+			template<typename T>
+			ptrdiff_t array_offset(const T* objects, size_t count) const
+			{
+				if (count == 0)
+					return -1;
+				auto object = const_cast<std::remove_const_t<T>*>(objects);
+				auto address = upcast(object, get_type_view<std::remove_const_t<T>>(), object_type());
+				if (address == nullptr)
+					return -1;
+				return static_cast<char*>(address) - reinterpret_cast<char*>(object);
+			}
+
+			template<typename V, typename Address>
+			bool get_many_impl(size_t count, V* values, const Address& address) const
+			{
+				if (value_type() != get_type_view<V>() || m_rank != 0)
+					return false;
+
+				if constexpr (std::is_copy_assignable_v<V>)
+				{
+					auto offset = layout().offset;
+					if (offset >= 0)
+					{
+						for (size_t i = 0; i < count; ++i)
+						{
+							auto object = static_cast<const char*>(address(i));
+							if (object == nullptr)
+								return false;
+							values[i] = *reinterpret_cast<const V*>(object + offset);
+						}
+						return true;
+					}
+				}
+				for (size_t i = 0; i < count; ++i)
+				{
+					auto object = address(i);
+					if (object == nullptr || !m_reader(m_instance, object, &values[i]))
+						return false;
+				}
+				return true;
+			}
+
+			template<typename V, typename Address>
+			bool set_many_impl(size_t count, const V* values, const Address& address) const
+			{
+				if (value_type() != get_type_view<V>() || m_rank != 0 || m_is_read_only)
+					return false;
+
+				if constexpr (std::is_copy_assignable_v<V>)
+				{
+					auto offset = layout().offset;
+					if (offset >= 0)
+					{
+						for (size_t i = 0; i < count; ++i)
+						{
+							auto object = static_cast<char*>(address(i));
+							if (object == nullptr)
+								return false;
+							*reinterpret_cast<V*>(object + offset) = values[i];
+						}
+						return true;
+					}
+				}
+				for (size_t i = 0; i < count; ++i)
+				{
+					auto object = address(i);
+					if (object == nullptr || !m_writer(m_instance, object, &values[i]))
+						return false;
+				}
+				return true;
+			}
+
+			const void* m_instance;
+			std::string_view		m_name;
+			std::string_view		m_display_name;
+			attribute_iterable		m_attributes;
+			value(*m_getter)(const void*, const value&, const index_base&);
+			bool(*m_setter)(const void*, const value&, const value&, const index_base&);
+			bool(*m_mover)(const void*, const value&, value&, const index_base&);
+			value(*m_refer)(const void*, const value&, const index_base&);
 			value(*m_crefer)(const void*, const value&, const index_base&);
+			value_ref(*m_viewer)(const void*, const value&, const index_base&);
+			bool(*m_reader)(const void*, const void*, void*);
+			bool(*m_writer)(const void*, void*, const void*);
+			property_layout(*m_layout)(const void*);
+			size_t(*m_slice_reader)(const void*, const value&, const index_base&, void*, size_t);
+			size_t(*m_slice_writer)(const void*, const value&, const index_base&, const void*, size_t);
 			const type_view&(*m_view_getter)();
+			const type_view&(*m_object_view_getter)();
+			size_t					m_rank;
+			bool					m_is_read_only;
+			bool					m_is_referable;
 		};
 
 
@@ -921,17 +2081,19 @@ namespace rtti
 
 			constexpr property_iterable()
 			{}
-			constexpr property_iterable(iterator begin, iterator end)
+			constexpr property_iterable(iterator begin, iterator end, const name_index_entry* index = nullptr)
 				: base_class(begin, end)
+				, m_index(index)
 			{}
 
 			constexpr const property_view* get(std::string_view name) const
 			{
-				return constexpr_find_if(base_class::begin(), base_class::end(), [name](const auto& i)
-					{
-						return name.compare(i.name()) == 0;
-					});
+				auto itr = find_by_name(base_class::begin(), base_class::end(), m_index, name);
+				return itr == base_class::end() ? nullptr : itr;
 			}
+
+		private:
+			const name_index_entry*	m_index = nullptr;
 		};
 
 		template<typename ...Types>
@@ -944,20 +2106,25 @@ namespace rtti
 
 			constexpr property_array(Types&&... args)
 				: base_class(std::forward<Types>(args)...)
+				, m_index(base_class::begin())
 			{}
 			constexpr property_array(const property_array& r)
 				: base_class(r)
+				, m_index(r.m_index)
 			{}
 
 			constexpr property_iterable iterable() const
 			{
-				return { base_class::begin(), base_class::end() };
+				return { base_class::begin(), base_class::end(), m_index.data() };
 			}
 
 			constexpr const property_view* get(std::string_view name) const
 			{
 				return iterable().get(name);
 			}
+
+		private:
+			name_index<sizeof...(Types)>	m_index;
 		};
 
 		class type_iterator
@@ -1034,10 +2201,11 @@ namespace rtti
 			constexpr type_iterator end() const { return { view, size() }; }
 			constexpr size_t size() const { return sizeof...(Types); }
 		private:
-			constexpr static const type_view& view(size_t index)
+			static constexpr const type_view& (*sm_getters[])() = { get_type_view<Types>... };
+
+			static const type_view& view(size_t index)
 			{
-				const type_view* views[] = { &get_type_view<Types>()... };
-				return *views[index];
+				return sm_getters[index]();
 			}
 		};
 		template<>
@@ -1078,7 +2246,28 @@ namespace rtti
 					(object->*m_invoker)(args...);
 				else
 					return (object->*m_invoker)(args...);
-				return {};
+			}
+		};
+		// A const member function, which may be invoked on const objects.
+		template<typename Class, typename Result, typename ...Args>
+		struct method_const_member_invoker : public method_invoker<Result, type_list<Args...>>
+		{
+			using invoker_type = Result(Class::*)(Args...) const;
+			using object_type = const Class;
+			using result_type = Result;
+
+			invoker_type	m_invoker;
+
+			constexpr method_const_member_invoker(invoker_type p)
+				: m_invoker(p)
+			{}
+
+			result_type invoke(object_type* object, const Args&... args) const
+			{
+				if constexpr (std::is_void_v<Result>)
+					(object->*m_invoker)(args...);
+				else
+					return (object->*m_invoker)(args...);
 			}
 		};
 		template<typename Fn, typename Result, typename Arglist>
@@ -1101,7 +2290,6 @@ namespace rtti
 					m_invoker(args...);
 				else
 					return m_invoker(args...);
-				return {};
 			}
 		};
 
@@ -1132,6 +2320,12 @@ namespace rtti
 				auto invoker = method_member_invoker<Class, Result, Args...>(p);
 				return method<decltype(invoker), Attributes>(m_name, m_display_name, m_attributes, invoker);
 			}
+			template<typename Class, typename Result, typename ...Args>
+			constexpr auto invoker(Result(Class::*p)(Args...) const) const
+			{
+				auto invoker = method_const_member_invoker<Class, Result, Args...>(p);
+				return method<decltype(invoker), Attributes>(m_name, m_display_name, m_attributes, invoker);
+			}
 
 			template<typename Fn>
 			constexpr auto invoker(Fn&& fn) const
@@ -1172,8 +2366,11 @@ namespace rtti
 			Invoker				m_invoker;
 		};
 
+		template<typename Signature> class bound_method;
+
 		class method_view
 		{
+			template<typename Signature> friend class bound_method;
 		public:
 			template<typename T>
 			constexpr method_view(const T& instance)
@@ -1184,7 +2381,15 @@ namespace rtti
 				, m_attributes(instance.attributes().iterable())
 				, m_invoker([](const void* instance, const value& object, arguments args)
 					{ return method_view::invokeT(reinterpret_cast<const T*>(instance), object, args, std::make_index_sequence<T::argument_list::size>()); })
+				, m_raw_invoker([](const void* instance, void* object, const void* const* args, void* result)
+					{ method_view::invoke_raw(reinterpret_cast<const T*>(instance), object, args, result, std::make_index_sequence<T::argument_list::size>()); })
+				, m_acceptor([](const value& object, arguments args)
+					{ return method_view::acceptsT<T>(object, args, std::make_index_sequence<T::argument_list::size>()); })
 				, m_result_type(get_type_view<typename T::result_type>)
+				, m_object_type(get_type_view<std::remove_const_t<typename T::object_type>>)
+				, m_signature_id(get_signature_id(typename T::argument_list()))
+				, m_result_id(get_type_id<std::decay_t<typename T::result_type>>())
+				, m_is_const(std::is_const_v<typename T::object_type>)
 			{}
 
 			constexpr std::string_view name() const { return m_name; }
@@ -1196,11 +2401,59 @@ namespace rtti
 			{
 				return m_invoker(m_instance, object, args);
 			}
+			// True when invoke() would call the method with object and args, rather than return an empty value.
+			bool is_invocable(const value& object, arguments args) const
+			{
+				return m_acceptor(object, args);
+			}
 
 			const type_view& result_type() const
 			{
 				return m_result_type();
 			}
+			// The class of the object for a member function, void for a delegate.
+			const type_view& object_type() const
+			{
+				return m_object_type();
+			}
+			// True for const member functions and delegates, which may be invoked on const objects.
+			constexpr bool is_const() const { return m_is_const; }
+
+			// Invokes with typed arguments, without boxing them into values.
+			// The signature is checked by its id, and the arguments must match the parameters after decay.
+			// A string literal matches a const char* parameter.
+			// Returns std::optional<R>, or bool when R is void, which is empty or false when it does not match.
+			// Results are returned by value, also for methods which return a reference.
+			template<typename R, typename T, typename... Args>
+			auto invoke_as(T* object, const Args&... args) const
+			{
+				using stored_type = std::decay_t<R>;
+				using result_type = std::conditional_t<std::is_void_v<R>, bool, std::optional<stored_type>>;
+
+				auto address = const_cast<void*>(static_cast<const void*>(object));
+				if (!is_invocable_as<R, frame_argument_t<Args>...>() || !resolve_object(address, get_type_view<std::remove_const_t<T>>(), std::is_const_v<T>))
+					return result_type();
+
+				const std::tuple<frame_argument_t<Args>...> frame(args...);
+				return std::apply([&](const auto&... values)
+					{
+						const void* arguments[] = { static_cast<const void*>(&values)..., nullptr };
+						return invoke_frame<R>(address, arguments);
+					}, frame);
+			}
+			template<typename R, typename... Args>
+			auto invoke_as(std::nullptr_t, const Args&... args) const
+			{
+				return invoke_as<R>(static_cast<void*>(nullptr), args...);
+			}
+
+			template<typename R, typename... Args>
+			constexpr bool is_invocable_as() const
+			{
+				return m_signature_id == get_signature_id<Args...>() && m_result_id == get_type_id<std::decay_t<R>>();
+			}
+			// Identifies the argument types, see get_signature_id.
+			constexpr type_id_t signature_id() const { return m_signature_id; }
 
 		private:
 			const void* m_instance;
@@ -1209,7 +2462,61 @@ namespace rtti
 			type_iterable			m_arguments_type;
 			attribute_iterable		m_attributes;
 			value(*m_invoker)(const void*, const value&, arguments) = nullptr;
+			void(*m_raw_invoker)(const void*, void*, const void* const*, void*) = nullptr;
+			bool(*m_acceptor)(const value&, arguments) = nullptr;
 			const type_view& (*m_result_type)() = nullptr;
+			const type_view& (*m_object_type)() = nullptr;
+			type_id_t				m_signature_id = 0;
+			type_id_t				m_result_id = 0;
+			bool					m_is_const = false;
+
+			inline bool resolve_object(void*& object, const type_view& type, bool is_const) const;
+
+			// Arrays and functions are passed as the pointers they decay to, so a string literal is passed as const char*.
+			// Other arguments are passed by reference, without copying them.
+			template<typename T>
+			using frame_argument_t = std::conditional_t<std::is_array_v<T> || std::is_function_v<T>, std::decay_t<const T&>, const T&>;
+
+			template<typename R>
+			auto invoke_frame(void* address, const void* const* arguments) const
+			{
+				using stored_type = std::decay_t<R>;
+				using result_type = std::conditional_t<std::is_void_v<R>, bool, std::optional<stored_type>>;
+
+				if constexpr (std::is_void_v<R>)
+				{
+					m_raw_invoker(m_instance, address, arguments, nullptr);
+					return true;
+				}
+				else
+				{
+					alignas(stored_type) unsigned char storage[sizeof(stored_type)];
+					m_raw_invoker(m_instance, address, arguments, storage);
+					auto& r = *reinterpret_cast<stored_type*>(storage);
+					result_type result(std::move(r));
+					r.~stored_type();
+					return result;
+				}
+			}
+
+			// Calls the invoker with unboxed arguments, and constructs the result in uninitialized storage.
+			// Results of reference types are copied into the storage of their decayed type.
+			template<typename T, size_t... Indices>
+			static void invoke_raw(const T* instance, void* object, const void* const* args, void* result, std::index_sequence<Indices...>)
+			{
+				auto p = static_cast<typename T::object_type*>(object);
+				if constexpr (std::is_void_v<typename T::result_type>)
+					instance->invoke(p, *static_cast<const std::decay_t<typename T::argument_list::template at<Indices>>*>(args[Indices])...);
+				else
+					new(result) std::decay_t<typename T::result_type>(instance->invoke(p, *static_cast<const std::decay_t<typename T::argument_list::template at<Indices>>*>(args[Indices])...));
+			}
+
+			template<typename T, size_t... Indices>
+			static bool acceptsT(const value& object, arguments args, std::index_sequence<Indices...>)
+			{
+				return args.size() == sizeof...(Indices) && value_cast_object<typename T::object_type>(object)
+					&& (value_cast<typename T::argument_list::template at<Indices>>(*(args.begin() + Indices)) && ...);
+			}
 
 			template<typename T, size_t... Indices>
 			static value invokeT(const T* instance, const value& object, arguments args, std::index_sequence<Indices...>)
@@ -1219,12 +2526,92 @@ namespace rtti
 					auto values = std::make_tuple(
 						value_cast<typename T::argument_list::template at<Indices>>(*(args.begin() + Indices))...);
 					if ((std::get<Indices>(values) && ...))
-						return instance->invoke(p, *std::get<Indices>(values)...);
+					{
+						if constexpr (std::is_void_v<typename T::result_type>)
+							instance->invoke(p, *std::get<Indices>(values)...);
+						else
+							return instance->invoke(p, *std::get<Indices>(values)...);
+					}
 				}
 				return {};
 			}
 		};
 
+		// A method resolved once, with its signature checked and optionally an object bound.
+		// Invoked with a fixed argument frame, without boxing the arguments.
+		template<typename R, typename... Args>
+		class bound_method<R(Args...)>
+		{
+			static_assert(!std::is_reference_v<R>, "Results are returned by value, R must not be a reference.");
+		public:
+			bound_method()
+			{}
+			inline explicit bound_method(const method_view& method);
+			template<typename T>
+			bound_method(const method_view& method, T* object)
+				: bound_method(method)
+			{
+				if (m_method && !resolve(object, m_object))
+					m_method = nullptr;
+			}
+
+			bool has_value() const { return m_method; }
+			explicit operator bool() const { return has_value(); }
+			const method_view* method() const { return m_method; }
+
+			// Invokes on the bound object. Returns R() when it has no value, or no object is bound to a member function.
+			R operator()(const Args&... args) const
+			{
+				if (m_method == nullptr || (m_object == nullptr && m_is_member))
+					return R();
+				return call(m_object, args...);
+			}
+			// Invokes on another object. Returns R() when the object does not match.
+			template<typename T>
+			R invoke(T* object, const Args&... args) const
+			{
+				void* address = nullptr;
+				if (!resolve(object, address))
+					return R();
+				return call(address, args...);
+			}
+
+		private:
+			const method_view*	m_method = nullptr;
+			void*				m_object = nullptr;
+			bool				m_is_member = false;	// which needs an object, found once instead of on each call
+
+			template<typename T>
+			bool resolve(T* object, void*& address) const
+			{
+				if (m_method == nullptr)
+					return false;
+				address = const_cast<void*>(static_cast<const void*>(object));
+				return m_method->resolve_object(address, get_type_view<std::remove_const_t<T>>(), std::is_const_v<T>);
+			}
+
+			R call(void* object, const Args&... args) const
+			{
+				if (m_method == nullptr)
+					return R();
+
+				const void* frame[] = { static_cast<const void*>(&args)..., nullptr };
+				if constexpr (std::is_void_v<R>)
+				{
+					m_method->m_raw_invoker(m_method->m_instance, object, frame, nullptr);
+				}
+				else
+				{
+					alignas(R) unsigned char storage[sizeof(R)];
+					m_method->m_raw_invoker(m_method->m_instance, object, frame, storage);
+					auto& r = *reinterpret_cast<R*>(storage);
+					R result(std::move(r));
+					r.~R();
+					return result;
+				}
+			}
+		};
+
 		class method_iterable
 			: public iterator_range<view_mapped_array<method_view>::iterator>
 		{
@@ -1232,17 +2619,39 @@ namespace rtti
 		public:
 			constexpr method_iterable()
 			{}
-			constexpr method_iterable(iterator begin, iterator end)
+			constexpr method_iterable(iterator begin, iterator end, const name_index_entry* index = nullptr)
 				: base_class(begin, end)
+				, m_index(index)
 			{}
 
 			constexpr const method_view* get(std::string_view name) const
 			{
-				return constexpr_find_if(base_class::begin(), base_class::end(), [name](const auto& i)
-					{
-						return name.compare(i.name()) == 0;
-					});
+				auto itr = find_by_name(base_class::begin(), base_class::end(), m_index, name);
+				return itr == base_class::end() ? nullptr : itr;
+			}
+			// Finds the overload of name taking the arguments identified by signature_id.
+			constexpr const method_view* get(std::string_view name, type_id_t signature_id) const
+			{
+				auto itr = find_by_name(base_class::begin(), base_class::end(), m_index, name,
+					[signature_id](const method_view& method) { return method.signature_id() == signature_id; });
+				return itr == base_class::end() ? nullptr : itr;
+			}
+
+			// Invokes the overload of name matching the types of args.
+			// When no overload matches exactly, as for a T* argument to a const T* parameter, each overload named name
+			// is tried in declaration order until one accepts object and args. Returns an empty value when none does.
+			value invoke(std::string_view name, const value& object, arguments args) const
+			{
+				if (auto method = get(name, get_signature_id(args)))
+					return method->invoke(object, args);
+
+				auto itr = find_by_name(base_class::begin(), base_class::end(), m_index, name,
+					[&](const method_view& method) { return method.is_invocable(object, args); });
+				return itr == base_class::end() ? value() : itr->invoke(object, args);
 			}
+
+		private:
+			const name_index_entry*	m_index = nullptr;
 		};
 
 		template<typename ...Types>
@@ -1255,22 +2664,54 @@ namespace rtti
 
 			constexpr method_array(Types&&... args)
 				: base_class(std::forward<Types>(args)...)
+				, m_index(base_class::begin())
 			{}
 			constexpr method_array(const method_array& r)
 				: base_class(r)
+				, m_index(r.m_index)
 			{}
 
 			constexpr method_iterable iterable() const
 			{
-				return { base_class::begin(), base_class::end() };
+				return { base_class::begin(), base_class::end(), m_index.data() };
 			}
 
 			constexpr const method_view* get(std::string_view name) const
 			{
 				return iterable().get(name);
 			}
+			constexpr const method_view* get(std::string_view name, type_id_t signature_id) const
+			{
+				return iterable().get(name, signature_id);
+			}
+
+		private:
+			name_index<sizeof...(Types)>	m_index;
+		};
+
+
+		// Where constructed objects go: count objects in storage when it is given,
+		// otherwise one object allocated from resource, or by new when resource is null.
+		struct construction_target
+		{
+			std::pmr::memory_resource*	resource = nullptr;
+			void*						storage = nullptr;
+			size_t						count = 1;
 		};
 
+		// Destroys the objects built so far in storage unless dismissed, when a constructor throws.
+		template<typename T>
+		struct construction_rollback
+		{
+			T*		objects;
+			size_t	count = 0;
+
+			~construction_rollback()
+			{
+				while (count != 0)
+					objects[--count].~T();
+			}
+		};
 
 		template<typename... Args>
 		class constructor
@@ -1279,9 +2720,24 @@ namespace rtti
 			using argument_list = type_list<Args...>;
 			using arguments_set = typename argument_list::template expand<type_array>;
 
-			template<typename T> static T* instantiate(const Args&... args)
+			static constexpr type_id_t signature_id() { return get_signature_id<Args...>(); }
+
+			template<typename T> static T* instantiate(const construction_target& target, const Args&... args)
 			{
-				return new T(args...);
+				if (target.storage)
+				{
+					construction_rollback<T> built = { static_cast<T*>(target.storage) };
+					for (; built.count < target.count; ++built.count)
+						new(built.objects + built.count) T(args...);
+					built.count = 0;
+					return built.objects;
+				}
+				if (target.resource == nullptr)
+					return new T(args...);
+				allocation_rollback allocated = { target.resource, target.resource->allocate(sizeof(T), alignof(T)), sizeof(T), alignof(T) };
+				auto object = new(allocated.address) T(args...);
+				allocated.address = nullptr;
+				return object;
 			}
 
 			constexpr const arguments_set& arguments_type() const { return m_arguments; }
@@ -1296,11 +2752,14 @@ namespace rtti
 			template<typename T>
 			constexpr constructor_view(const T& instance)
 				: m_arguments_type(instance.arguments_type().iterable())
+				, m_signature_id(instance.signature_id())
 			{}
 
 			constexpr type_iterable arguments_type() const { return m_arguments_type; }
+			constexpr type_id_t signature_id() const { return m_signature_id; }
 		private:
 			type_iterable			m_arguments_type;
+			type_id_t				m_signature_id = 0;
 		};
 
 		class constructor_iterable
@@ -1335,94 +2794,811 @@ namespace rtti
 				return { base_class::begin(), base_class::end() };
 			}
 
-			value instantiate(arguments args) const
+			// Dispatches to the constructor whose signature matches the types of args.
+			// Falls back to trying each constructor in order, which allows conversions such as T* to const T*.
+			value instantiate(std::pmr::memory_resource* resource, arguments args) const
+			{
+				return construct({ resource }, args);
+			}
+			// Null storage is rejected, as construct would allocate then.
+			bool instantiate_at(void* storage, size_t count, arguments args) const
 			{
-				return instantiate_match<Types...>(args);
+				return storage != nullptr && construct({ nullptr, storage, count }, args) != nullptr;
 			}
 
 		private:
+			static T* construct(const construction_target& target, arguments args)
+			{
+				auto signature_id = get_signature_id(args);
+				for (size_t i = 0; i < sm_signature_ids.size(); ++i)
+				{
+					if (sm_signature_ids[i] == signature_id)
+					{
+						if (auto p = sm_instantiators[i](target, args))
+							return p;
+					}
+				}
+				return instantiate_match<Types...>(target, args);
+			}
+
 			template<typename Ctor = void, typename... Rest>
-			T* instantiate_match(arguments args) const
+			static T* instantiate_match(const construction_target& target, arguments args)
 			{
-				if (auto p = invoke_ctor<Ctor>(args, std::make_index_sequence<Ctor::argument_list::size>()))
-					return p;
-				return instantiate_match<Rest...>(args);
+				if constexpr (std::is_void_v<Ctor>)
+					return nullptr;
+				else
+				{
+					if (auto p = instantiate_with<Ctor>(target, args))
+						return p;
+					return instantiate_match<Rest...>(target, args);
+				}
 			}
-			template<>
-			T* instantiate_match<>(arguments args) const
+			template<typename Ctor>
+			static T* instantiate_with(const construction_target& target, arguments args)
 			{
-				return nullptr;
+				return invoke_ctor<Ctor>(target, args, std::make_index_sequence<Ctor::argument_list::size>());
 			}
 			template<typename Ctor, size_t... Indices>
-			T* invoke_ctor(arguments args, std::index_sequence<Indices...>) const
+			static T* invoke_ctor(const construction_target& target, arguments args, std::index_sequence<Indices...>)
 			{
 				if (args.size() != sizeof...(Indices))
 					return nullptr;
 
 				auto values = std::make_tuple(value_cast<typename Ctor::argument_list::template at<Indices> >(*(args.begin() + Indices))...);
 				if ((std::get<Indices>(values) && ...))
-					return Ctor::template instantiate<T>(*std::get<Indices>(values)...);
+					return Ctor::template instantiate<T>(target, *std::get<Indices>(values)...);
 				return nullptr;
 			}
+
+			static constexpr std::array<type_id_t, sizeof...(Types)> sm_signature_ids = { Types::signature_id()... };
+			static constexpr std::array<T* (*)(const construction_target&, arguments), sizeof...(Types)> sm_instantiators = { &instantiate_with<Types>... };
 		};
 		template<>
 		class constructor_array<void>
 		{
 		public:
 			constexpr constructor_iterable iterable() const{ return { }; }
-			value instantiate(arguments args) const { return {}; }
+			value instantiate(std::pmr::memory_resource* resource, arguments args) const { return {}; }
+			bool instantiate_at(void* storage, size_t count, arguments args) const { return false; }
 		};
 
-		class type_view : noncopyable
+		// Adjusts the address of a derived object to one of its direct base subobjects.
+		struct base_cast
 		{
-		public:
+			void* (*upcast)(void*) = nullptr;
+			bool is_virtual = false;
+		};
 
-			template<typename T>
-			constexpr type_view(const T&)
-				: m_name(T::name())
-				, m_display_name(T::display_name())
-				, m_id(T::id())
-				, m_bases(T::bases().iterable())
-				, m_constructors(T::constructors().iterable())
-				, m_properties(T::properties().iterable())
-				, m_methods(T::methods().iterable())
-				, m_attributes(T::attributes().iterable())
-				, m_constructor([](arguments args) { return T::instantiate(args); })
-				, m_has_description(T::has_description())
-				, m_is_const(T::is_const())
-				, m_is_volatile(T::is_volatile())
-				, m_is_reference(T::is_reference())
-				, m_is_pointer(T::is_pointer())
-				, m_rank(T::rank())
-				, m_decay_type(get_type_view<typename T::decay_type>)
-				, m_unconst_type(get_type_view<typename T::unconst_type>)
-				, m_const_type(get_type_view<typename T::const_type>)
-				, m_unpointer_type(get_type_view<typename T::unpointer_type>)
-				, m_once_pointer_type(get_type_view<typename T::once_pointer_type>)
+		template<typename Derived, typename Base>
+		void* upcast_object(void* object)
+		{
+			return static_cast<Base*>(static_cast<Derived*>(object));
+		}
+
+		// A virtual base can not be downcast by static_cast.
+		template<typename Base, typename Derived, typename = void>
+		struct is_virtual_base_of : public std::is_base_of<Base, Derived>
+		{};
+		template<typename Base, typename Derived>
+		struct is_virtual_base_of<Base, Derived, std::void_t<decltype(static_cast<Derived*>(std::declval<Base*>()))>>
+			: public std::false_type
+		{};
+
+		template<typename E>
+		struct enumerator
+		{
+			static_assert(std::is_enum_v<E>);
+
+			std::string_view	name;
+			E					value;
+
+			constexpr enumerator(std::string_view name, E value)
+				: name(name)
+				, value(value)
+			{}
+		};
+
+		class enumerator_view
+		{
+		public:
+			constexpr enumerator_view()
+			{}
+			template<typename E>
+			constexpr enumerator_view(const enumerator<E>& e)
+				: m_name(e.name)
+				, m_value(static_cast<int64_t>(e.value))
 			{}
 
 			constexpr std::string_view name() const { return m_name; }
-			constexpr std::string_view display_name() const { return m_display_name; }
-			constexpr type_id_t id() const { return m_id; }
-			constexpr type_iterable bases() const { return m_bases; }
-			constexpr constructor_iterable constructors() const { return m_constructors; }
+			// The value converted from the underlying type.
+			constexpr int64_t value() const { return m_value; }
+
+		private:
+			std::string_view	m_name;
+			int64_t				m_value = 0;
+		};
+
+		// Slot of a name in the name table of enumerator_array.
+		// The whole name is hashed, as names sharing a prefix and a length, like FLAG_A to FLAG_Z, are common.
+		constexpr size_t enumerator_slot(std::string_view name, size_t mask)
+		{
+			// hash() is a weak string hash, spread it before masking.
+			return (size_t)((hash(name) * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+		}
+
+		class enumerator_iterable
+			: public iterator_range<const enumerator_view*>
+		{
+			using base_class = iterator_range<const enumerator_view*>;
+		public:
+			// Lookup tables built by enumerator_array.
+			struct tables
+			{
+				const uint32_t*	slots;			// position + 1 by name hash, 0 for empty slots
+				size_t			slot_mask;
+				const uint32_t*	by_value;		// positions sorted by value
+				int64_t			min_value;
+				bool			is_dense;		// values are min_value, min_value + 1, ... without gaps
+			};
+
+			constexpr enumerator_iterable()
+			{}
+			constexpr enumerator_iterable(iterator begin, iterator end, const tables& tables)
+				: base_class(begin, end)
+				, m_tables(tables)
+			{}
+
+			// Finds the enumerator named name.
+			constexpr const enumerator_view* get(std::string_view name) const
+			{
+				if (base_class::size() == 0)
+					return nullptr;
+				for (auto i = enumerator_slot(name, m_tables.slot_mask); m_tables.slots[i] != 0; i = (i + 1) & m_tables.slot_mask)
+				{
+					auto itr = base_class::begin() + (m_tables.slots[i] - 1);
+					if (itr->name() == name)
+						return itr;
+				}
+				return nullptr;
+			}
+			// Finds the first declared enumerator which has value.
+			constexpr const enumerator_view* get_by_value(int64_t value) const
+			{
+				auto size = base_class::size();
+				if (m_tables.is_dense)
+				{
+					auto i = static_cast<uint64_t>(value) - static_cast<uint64_t>(m_tables.min_value);
+					return i < size ? base_class::begin() + m_tables.by_value[i] : nullptr;
+				}
+
+				size_t lower = 0;
+				size_t upper = size;
+				while (lower < upper)
+				{
+					auto middle = lower + (upper - lower) / 2;
+					if (at_value(middle) < value)
+						lower = middle + 1;
+					else
+						upper = middle;
+				}
+				if (lower < size && at_value(lower) == value)
+					return base_class::begin() + m_tables.by_value[lower];
+				return nullptr;
+			}
+
+			// Writes the names of the flags in value joined by separator, with a zero value written as its enumerator.
+			// Returns false when value has bits which no enumerator names.
+			bool format_flags(int64_t value, std::string& text, char separator = '|') const
+			{
+				text.clear();
+				if (value == 0)
+				{
+					if (auto e = get_by_value(0))
+						text = e->name();
+					return true;
+				}
+
+				auto rest = static_cast<uint64_t>(value);
+				for (auto& e : *this)
+				{
+					auto bits = static_cast<uint64_t>(e.value());
+					if (bits == 0 || (static_cast<uint64_t>(value) & bits) != bits || (rest & bits) == 0)
+						continue;
+					if (!text.empty())
+						text += separator;
+					text += e.name();
+					rest &= ~bits;
+				}
+				return rest == 0;
+			}
+			// Parses names joined by separator into value. Spaces around the names are ignored.
+			// Returns false when a name is unknown.
+			constexpr bool parse_flags(std::string_view text, int64_t& value, char separator = '|') const
+			{
+				uint64_t bits = 0;
+				while (!text.empty())
+				{
+					auto end = text.find(separator);
+					auto name = trim(text.substr(0, end));
+					auto e = get(name);
+					if (e == nullptr)
+						return false;
+					bits |= static_cast<uint64_t>(e->value());
+					if (end == std::string_view::npos)
+						break;
+					text.remove_prefix(end + 1);
+				}
+				value = static_cast<int64_t>(bits);
+				return true;
+			}
+
+		private:
+			tables m_tables = {};
+
+			constexpr int64_t at_value(size_t i) const { return (base_class::begin() + m_tables.by_value[i])->value(); }
+
+			static constexpr std::string_view trim(std::string_view s)
+			{
+				while (!s.empty() && s.front() == ' ')
+					s.remove_prefix(1);
+				while (!s.empty() && s.back() == ' ')
+					s.remove_suffix(1);
+				return s;
+			}
+		};
+
+		// Enumerators with a name table, open addressed at half load, and a value table sorted by value.
+		template<size_t Size>
+		class enumerator_array
+		{
+		public:
+			static constexpr size_t slot_count = [] { size_t n = 1; while (n < Size * 2) n *= 2; return n; }();
+
+			constexpr enumerator_array()
+				: m_items{}
+				, m_slots{}
+				, m_by_value{}
+			{}
+			template<typename... Enumerators>
+			constexpr enumerator_array(const Enumerators&... enumerators)
+				: m_items{ enumerator_view(enumerators)... }
+				, m_slots{}
+				, m_by_value{}
+			{
+				for (size_t i = 0; i < Size; ++i)
+				{
+					auto slot = enumerator_slot(m_items[i].name(), slot_count - 1);
+					while (m_slots[slot] != 0)
+						slot = (slot + 1) & (slot_count - 1);
+					m_slots[slot] = static_cast<uint32_t>(i + 1);
+
+					// Insertion keeps declaration order among equal values.
+					auto j = i;
+					for (; j > 0 && m_items[i].value() < m_items[m_by_value[j - 1]].value(); --j)
+						m_by_value[j] = m_by_value[j - 1];
+					m_by_value[j] = static_cast<uint32_t>(i);
+				}
+
+				if constexpr (Size > 0)
+				{
+					m_min_value = m_items[m_by_value[0]].value();
+					m_is_dense = true;
+					for (size_t i = 0; i < Size; ++i)
+						m_is_dense = m_is_dense && m_items[m_by_value[i]].value() == m_min_value + static_cast<int64_t>(i);
+				}
+			}
+
+			constexpr enumerator_iterable iterable() const
+			{
+				if constexpr (Size == 0)
+					return {};
+				else
+					return { m_items.data(), m_items.data() + Size, { m_slots.data(), slot_count - 1, m_by_value.data(), m_min_value, m_is_dense } };
+			}
+
+		private:
+			std::array<enumerator_view, Size>	m_items;
+			std::array<uint32_t, slot_count>	m_slots;
+			std::array<uint32_t, Size>			m_by_value;
+			int64_t								m_min_value = 0;
+			bool								m_is_dense = false;
+		};
+
+		template<typename C, typename = void>
+		struct is_container : public std::false_type
+		{};
+		// Anything iterable with size() whose elements are addressable, which leaves out std::vector<bool>.
+		template<typename C>
+		struct is_container<C, std::void_t<typename C::value_type, typename C::iterator, decltype(std::declval<const C&>().size())>>
+			: public std::bool_constant<std::is_reference_v<decltype(*std::declval<C&>().begin())>>
+		{};
+
+		template<template<typename> typename Op, typename C, typename = void>
+		struct has_operation : public std::false_type
+		{};
+		template<template<typename> typename Op, typename C>
+		struct has_operation<Op, C, std::void_t<Op<C>>> : public std::true_type
+		{};
+
+		template<typename C, typename = void>
+		struct container_key_type
+		{
+			using type = void;
+		};
+		template<typename C>
+		struct container_key_type<C, std::void_t<typename C::key_type>>
+		{
+			using type = typename C::key_type;
+		};
+		template<typename C, typename = void>
+		struct container_mapped_type
+		{
+			using type = void;
+		};
+		template<typename C>
+		struct container_mapped_type<C, std::void_t<typename C::mapped_type>>
+		{
+			using type = typename C::mapped_type;
+		};
+
+		template<typename C>
+		struct container_traits
+		{
+			template<typename T> using data_op = decltype(std::declval<T&>().data());
+			template<typename T> using insert_op = decltype(std::declval<T&>().insert(std::declval<T&>().end(), std::declval<const typename T::value_type&>()));
+			template<typename T> using emplace_op = decltype(std::declval<T&>().emplace(std::declval<const typename T::key_type&>(), std::declval<const typename T::mapped_type&>()));
+			template<typename T> using erase_op = decltype(std::declval<T&>().erase(std::declval<typename T::iterator&>()));
+			template<typename T> using find_op = decltype(std::declval<T&>().find(std::declval<const typename T::key_type&>()));
+			template<typename T> using clear_op = decltype(std::declval<T&>().clear());
+			template<typename T> using reserve_op = decltype(std::declval<T&>().reserve(size_t()));
+			template<typename T> using resize_op = decltype(std::declval<T&>().resize(size_t()));
+
+			using iterator = typename C::iterator;
+			using element_type = typename C::value_type;
+			using key_type = typename container_key_type<C>::type;
+			using mapped_type = typename container_mapped_type<C>::type;
+
+			static constexpr bool is_random_access = std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<iterator>::iterator_category>;
+			static constexpr bool is_contiguous = is_random_access && has_operation<data_op, C>::value;
+			static constexpr bool is_associative = has_operation<find_op, C>::value;
+			static constexpr bool is_map = is_associative && !std::is_void_v<mapped_type>;
+			// Elements are inserted as copies, which move-only elements can not be.
+			static constexpr bool is_copy_insertable = std::is_copy_constructible_v<element_type>
+				&& (std::is_void_v<key_type> || std::is_copy_constructible_v<key_type>)
+				&& (std::is_void_v<mapped_type> || std::is_copy_constructible_v<mapped_type>);
+			// Sequences which shift their elements on insertion and erasure assign them, list-like sequences and associative containers do not.
+			static constexpr bool is_insertable = is_copy_insertable && has_operation<insert_op, C>::value
+				&& (!is_random_access || (std::is_copy_assignable_v<element_type> && std::is_move_assignable_v<element_type>));
+			static constexpr bool is_erasable = has_operation<erase_op, C>::value
+				&& (!is_random_access || std::is_move_assignable_v<element_type>);
+			// resize() appends default constructed elements, and moves the others when it reallocates.
+			static constexpr bool is_resizable = has_operation<resize_op, C>::value
+				&& std::is_default_constructible_v<element_type> && std::is_move_constructible_v<element_type>;
+			// Elements of sets are immutable.
+			static constexpr bool is_element_const = std::is_const_v<std::remove_reference_t<decltype(*std::declval<iterator&>())>>;
+
+			static C& get(const void* container) { return *const_cast<C*>(static_cast<const C*>(container)); }
+			static void* address(const element_type& element) { return const_cast<element_type*>(std::addressof(element)); }
+		};
+
+		class container_cursor;
+
+		// Operations on a standard container, which type_view::container() exposes.
+		// The container arguments are addresses of the type the view belongs to.
+		class container_view
+		{
+			friend class container_cursor;
+		public:
+			// Iterators of standard containers are a few pointers even in debug builds.
+			static constexpr size_t cursor_capacity = sizeof(void*) * 8;
+
+			template<typename C>
+			constexpr container_view(type_list<C>)
+				: m_element_type(get_type_view<typename container_traits<C>::element_type>)
+				, m_key_type(get_type_view<typename container_traits<C>::key_type>)
+				, m_mapped_type(get_type_view<typename container_traits<C>::mapped_type>)
+				, m_size([](const void* container) -> size_t { return container_traits<C>::get(container).size(); })
+				, m_data([](const void* container) -> void*
+					{
+						using traits = container_traits<C>;
+						if constexpr (traits::is_contiguous)
+							return const_cast<void*>(static_cast<const void*>(traits::get(container).data()));
+						else
+							return nullptr;
+					})
+				, m_at([](const void* container, size_t index) -> void*
+					{
+						using traits = container_traits<C>;
+						if constexpr (traits::is_random_access)
+						{
+							auto& c = traits::get(container);
+							if (index < c.size())
+								return traits::address(*(c.begin() + index));
+						}
+						return nullptr;
+					})
+				, m_find([](const void* container, const value& key) -> void*
+					{
+						using traits = container_traits<C>;
+						if constexpr (traits::is_associative)
+						{
+							auto k = value_cast<typename traits::key_type>(key);
+							if (k == nullptr)
+								return nullptr;
+							auto& c = traits::get(container);
+							auto itr = c.find(*k);
+							if (itr == c.end())
+								return nullptr;
+							if constexpr (traits::is_map)
+								return const_cast<typename traits::mapped_type*>(&itr->second);
+							else
+								return traits::address(*itr);
+						}
+						else
+							return nullptr;
+					})
+				, m_insert([](void* container, const value& element) -> bool
+					{
+						using traits = container_traits<C>;
+						if constexpr (traits::is_insertable)
+						{
+							if (auto e = value_cast<typename traits::element_type>(element))
+							{
+								auto& c = traits::get(container);
+								c.insert(c.end(), *e);
+								return true;
+							}
+						}
+						return false;
+					})
+				, m_emplace([](void* container, const value& key, const value& mapped) -> bool
+					{
+						using traits = container_traits<C>;
+						if constexpr (traits::is_map && traits::is_copy_insertable && has_operation<traits::template emplace_op, C>::value)
+						{
+							auto k = value_cast<typename traits::key_type>(key);
+							auto m = value_cast<typename traits::mapped_type>(mapped);
+							if (k && m)
+							{
+								traits::get(container).emplace(*k, *m);
+								return true;
+							}
+						}
+						return false;
+					})
+				, m_clear([](void* container)
+					{
+						if constexpr (has_operation<container_traits<C>::template clear_op, C>::value)
+							container_traits<C>::get(container).clear();
+					})
+				, m_reserve([](void* container, size_t count) -> bool
+					{
+						if constexpr (has_operation<container_traits<C>::template reserve_op, C>::value)
+						{
+							container_traits<C>::get(container).reserve(count);
+							return true;
+						}
+						else
+							return false;
+					})
+				, m_resize([](void* container, size_t count) -> bool
+					{
+						if constexpr (container_traits<C>::is_resizable)
+						{
+							container_traits<C>::get(container).resize(count);
+							return true;
+						}
+						else
+							return false;
+					})
+				, m_begin([](const void* container, void* iterator)
+					{
+						using iterator_type = typename container_traits<C>::iterator;
+						static_assert(sizeof(iterator_type) <= cursor_capacity && alignof(iterator_type) <= alignof(std::max_align_t));
+						new(iterator) iterator_type(container_traits<C>::get(container).begin());
+					})
+				, m_destroy_cursor([](void* iterator)
+					{
+						using iterator_type = typename container_traits<C>::iterator;
+						static_cast<iterator_type*>(iterator)->~iterator_type();
+					})
+				, m_is_end([](const void* container, const void* iterator) -> bool
+					{
+						return *static_cast<const typename container_traits<C>::iterator*>(iterator) == container_traits<C>::get(container).end();
+					})
+				, m_advance([](void* iterator) { ++*static_cast<typename container_traits<C>::iterator*>(iterator); })
+				, m_element([](const void* iterator) -> void*
+					{
+						return container_traits<C>::address(**static_cast<const typename container_traits<C>::iterator*>(iterator));
+					})
+				, m_key([](const void* iterator) -> void*
+					{
+						using traits = container_traits<C>;
+						auto& itr = *static_cast<const typename traits::iterator*>(iterator);
+						if constexpr (traits::is_map)
+							return const_cast<typename traits::key_type*>(&itr->first);
+						else if constexpr (traits::is_associative)
+							return traits::address(*itr);
+						else
+							return nullptr;
+					})
+				, m_mapped([](const void* iterator) -> void*
+					{
+						using traits = container_traits<C>;
+						if constexpr (traits::is_map)
+							return &(*static_cast<const typename traits::iterator*>(iterator))->second;
+						else
+							return nullptr;
+					})
+				, m_erase([](void* container, void* iterator) -> bool
+					{
+						using traits = container_traits<C>;
+						if constexpr (traits::is_erasable)
+						{
+							auto& itr = *static_cast<typename traits::iterator*>(iterator);
+							itr = traits::get(container).erase(itr);
+							return true;
+						}
+						else
+							return false;
+					})
+				, m_is_random_access(container_traits<C>::is_random_access)
+				, m_is_contiguous(container_traits<C>::is_contiguous)
+				, m_is_associative(container_traits<C>::is_associative)
+				, m_is_map(container_traits<C>::is_map)
+				, m_is_element_const(container_traits<C>::is_element_const)
+			{}
+
+			// value_type of the container, std::pair<const Key, T> for maps.
+			const type_view& element_type() const { return m_element_type(); }
+			// void unless the container is associative.
+			const type_view& key_type() const { return m_key_type(); }
+			// void unless the container is a map.
+			const type_view& mapped_type() const { return m_mapped_type(); }
+			constexpr bool is_random_access() const { return m_is_random_access; }
+			// The elements are an array which data() points to.
+			constexpr bool is_contiguous() const { return m_is_contiguous; }
+			constexpr bool is_associative() const { return m_is_associative; }
+
+			size_t size(const void* container) const { return m_size(container); }
+			// Returns nullptr unless is_contiguous().
+			void* data(void* container) const { return m_data(container); }
+			const void* data(const void* container) const { return m_data(container); }
+
+			// Refers the element at index. Returns an empty reference when out of range or not is_random_access().
+			value_ref at(void* container, size_t index) const { return refer(m_at(container, index), element_type(), m_is_element_const); }
+			value_ref at(const void* container, size_t index) const { return refer(m_at(container, index), element_type(), true); }
+			// Refers the mapped value for maps and the element for sets.
+			value_ref find(void* container, const value& key) const { return refer(m_find(container, key), found_type(), m_is_element_const); }
+			value_ref find(const void* container, const value& key) const { return refer(m_find(container, key), found_type(), true); }
+
+			// Iterates the elements from the first.
+			inline container_cursor begin(void* container) const;
+			inline container_cursor begin(const void* container) const;
+
+			// Appends the element, or inserts it for associative containers.
+			// Returns false when the element is not element_type(), the container has a fixed size, or its elements can not be copied or assigned.
+			bool insert(void* container, const value& element) const { return m_insert(container, element); }
+			// Inserts the pair into a map.
+			bool insert(void* container, const value& key, const value& mapped) const { return m_emplace(container, key, mapped); }
+			// Erases the element at the cursor, which moves to the next element.
+			// Returns false when the container has a fixed size, or its elements can not be assigned.
+			inline bool erase(void* container, container_cursor& cursor) const;
+			void clear(void* container) const { m_clear(container); }
+			// Returns false when the container has no such operation, or for resize(), when its elements can not be default constructed.
+			bool reserve(void* container, size_t count) const { return m_reserve(container, count); }
+			bool resize(void* container, size_t count) const { return m_resize(container, count); }
+			// Resizes the container to count elements for a reader. Containers of a fixed size must already have count elements.
+			bool fit(void* container, size_t count) const { return resize(container, count) || size(container) == count; }
+
+		private:
+			const type_view& found_type() const { return m_is_map ? m_mapped_type() : m_element_type(); }
+
+			static value_ref refer(void* address, const type_view& type, bool is_const)
+			{
+				if (address == nullptr)
+					return {};
+				if (is_const)
+					return { type, static_cast<const void*>(address) };
+				return { type, address };
+			}
+
+			const type_view&(*m_element_type)();
+			const type_view&(*m_key_type)();
+			const type_view&(*m_mapped_type)();
+			size_t(*m_size)(const void*);
+			void*(*m_data)(const void*);
+			void*(*m_at)(const void*, size_t);
+			void*(*m_find)(const void*, const value&);
+			bool(*m_insert)(void*, const value&);
+			bool(*m_emplace)(void*, const value&, const value&);
+			void(*m_clear)(void*);
+			bool(*m_reserve)(void*, size_t);
+			bool(*m_resize)(void*, size_t);
+			void(*m_begin)(const void*, void*);
+			void(*m_destroy_cursor)(void*);
+			bool(*m_is_end)(const void*, const void*);
+			void(*m_advance)(void*);
+			void*(*m_element)(const void*);
+			void*(*m_key)(const void*);
+			void*(*m_mapped)(const void*);
+			bool(*m_erase)(void*, void*);
+			bool	m_is_random_access;
+			bool	m_is_contiguous;
+			bool	m_is_associative;
+			bool	m_is_map;
+			bool	m_is_element_const;
+		};
+
+		// Position in a container. It holds the iterator, so the elements are visited without copying.
+		class container_cursor : noncopyable
+		{
+			friend class container_view;
+		public:
+			container_cursor(const container_view& view, const void* container, bool is_const)
+				: m_view(&view)
+				, m_container(const_cast<void*>(container))
+				, m_is_const(is_const)
+			{
+				m_view->m_begin(m_container, m_iterator);
+			}
+			~container_cursor()
+			{
+				m_view->m_destroy_cursor(m_iterator);
+			}
+
+			bool is_end() const { return m_view->m_is_end(m_container, m_iterator); }
+			void next() { m_view->m_advance(m_iterator); }
+
+			// The current element, which must not be the end.
+			value_ref get() const { return refer(m_view->m_element(m_iterator), m_view->element_type()); }
+			// The key of the current element for associative containers.
+			value_ref key() const { return container_view::refer(m_view->m_key(m_iterator), m_view->key_type(), true); }
+			// The mapped value of the current element for maps.
+			value_ref mapped() const { return refer(m_view->m_mapped(m_iterator), m_view->mapped_type()); }
+
+		private:
+			const container_view*	m_view;
+			void*					m_container;
+			bool					m_is_const;
+			alignas(std::max_align_t) char m_iterator[container_view::cursor_capacity];
+
+			value_ref refer(void* address, const type_view& type) const
+			{
+				return container_view::refer(address, type, m_is_const || m_view->m_is_element_const);
+			}
+		};
+
+		inline container_cursor container_view::begin(void* container) const
+		{
+			return { *this, container, false };
+		}
+		inline container_cursor container_view::begin(const void* container) const
+		{
+			return { *this, container, true };
+		}
+		inline bool container_view::erase(void* container, container_cursor& cursor) const
+		{
+			if (cursor.m_is_const || cursor.m_container != container)
+				return false;
+			return m_erase(container, cursor.m_iterator);
+		}
+
+		template<typename C>
+		inline constexpr container_view container_view_instance = container_view(type_list<C>());
+
+		class type_view : noncopyable
+		{
+		public:
+
+			template<typename T>
+			constexpr type_view(const T&)
+				: m_name(T::name())
+				, m_display_name(T::display_name())
+				, m_id(T::id())
+				, m_bases(T::bases().iterable())
+				, m_ancestors(T::ancestors().data())
+				, m_ancestor_count(T::ancestors().size)
+				, m_base_casts(T::base_casts())
+				, m_constructors(T::constructors().iterable())
+				, m_properties(T::properties().iterable())
+				, m_methods(T::methods().iterable())
+				, m_attributes(T::attributes().iterable())
+				, m_container(T::container())
+				, m_enumerators(T::enumerators())
+				, m_constructor([](std::pmr::memory_resource* resource, arguments args) { return T::instantiate(resource, args); })
+				, m_placement_constructor([](void* storage, size_t count, arguments args) { return T::instantiate_at(storage, count, args); })
+				, m_destructor([](void* objects, size_t count) { T::destroy(objects, count); })
+				, m_size(T::size())
+				, m_alignment(T::alignment())
+				, m_has_description(T::has_description())
+				, m_is_const(T::is_const())
+				, m_is_volatile(T::is_volatile())
+				, m_is_reference(T::is_reference())
+				, m_is_pointer(T::is_pointer())
+				, m_is_enum(T::is_enum())
+				, m_is_trivially_copyable(T::is_trivially_copyable())
+				, m_is_integral(T::is_integral())
+				, m_is_floating_point(T::is_floating_point())
+				, m_is_signed(T::is_signed())
+				, m_rank(T::rank())
+				, m_decay_type(get_type_view<typename T::decay_type>)
+				, m_unconst_type(get_type_view<typename T::unconst_type>)
+				, m_const_type(get_type_view<typename T::const_type>)
+				, m_unpointer_type(get_type_view<typename T::unpointer_type>)
+				, m_once_pointer_type(get_type_view<typename T::once_pointer_type>)
+			{}
+
+			constexpr std::string_view name() const { return m_name; }
+			constexpr std::string_view display_name() const { return m_display_name; }
+			constexpr type_id_t id() const { return m_id; }
+			constexpr type_iterable bases() const { return m_bases; }
+			// Sorted ids of all direct and indirect bases.
+			constexpr iterator_range<const type_id_t*> ancestors() const { return { m_ancestors, m_ancestors + m_ancestor_count }; }
+			// Address adjustments to the direct bases, in the same order as bases().
+			iterator_range<const base_cast*> base_casts() const { return { m_base_casts, m_base_casts + m_bases.size() }; }
+			constexpr constructor_iterable constructors() const { return m_constructors; }
 			constexpr property_iterable properties() const { return m_properties; }
 			constexpr method_iterable methods() const { return m_methods; }
 			constexpr attribute_iterable attributes() const { return m_attributes; }
+			// Element access for standard containers, nullptr for other types.
+			constexpr const container_view* container() const { return m_container; }
+			// Named values of an enum described by rtti_enum_impl.
+			constexpr enumerator_iterable enumerators() const { return m_enumerators; }
 			constexpr bool has_description() const { return m_has_description; }
 			constexpr bool is_const() const { return m_is_const; }
 			constexpr bool is_volatile() const { return m_is_volatile; }
 			constexpr bool is_reference() const { return m_is_reference; }
 			constexpr bool is_pointer() const { return m_is_pointer; }
+			constexpr bool is_enum() const { return m_is_enum; }
+			constexpr bool is_trivially_copyable() const { return m_is_trivially_copyable; }
+			constexpr bool is_integral() const { return m_is_integral; }
+			constexpr bool is_floating_point() const { return m_is_floating_point; }
+			// Signedness of the underlying type for enums.
+			constexpr bool is_signed() const { return m_is_signed; }
 			constexpr size_t rank() const { return m_rank; }
 			constexpr bool operator==(const type_view& q) const { return id() == q.id(); }
 			constexpr bool operator!=(const type_view& q) const { return !operator==(q); }
 			template<typename T>
 			constexpr bool is() const { return *this == get_type_view<T>(); }
+			// Constructs the object by new, which the caller deletes, also inside a memory_resource_scope.
+			// Objects are placed in a resource only by the overload which is given it.
 			value instantiate(arguments args) const
 			{
-				return m_constructor(args);
+				return m_constructor(nullptr, args);
+			}
+			// Constructs the object in memory from the resource.
+			// The object must be destructed by the caller, and the memory returns with the resource.
+			value instantiate(std::pmr::memory_resource* resource, arguments args) const
+			{
+				return m_constructor(resource, args);
+			}
+			// Constructs the object in storage, which must have size() and alignment().
+			// Returns an empty reference when storage is null or no constructor matches args. The object must be destroyed by destroy().
+			value_ref instantiate_at(void* storage, arguments args) const
+			{
+				if (!m_placement_constructor(storage, 1, args))
+					return {};
+				return { *this, storage };
 			}
+			// Constructs count objects with the same args in contiguous storage.
+			// When a constructor throws, the objects already constructed are destroyed.
+			bool instantiate_n(void* storage, size_t count, arguments args) const
+			{
+				return m_placement_constructor(storage, count, args);
+			}
+			// Destructs objects without releasing their memory.
+			void destroy(void* object) const
+			{
+				m_destructor(object, 1);
+			}
+			void destroy_n(void* objects, size_t count) const
+			{
+				m_destructor(objects, count);
+			}
+			// Size and alignment of an object, 0 for types which are not object types.
+			constexpr size_t size() const { return m_size; }
+			constexpr size_t alignment() const { return m_alignment; }
 
 			const type_view& decay_type() const { return m_decay_type(); }
 			const type_view& unconst_type() const { return m_unconst_type(); }
@@ -1434,16 +3610,30 @@ namespace rtti
 			std::string_view m_display_name;
 			type_id_t	m_id = 0;
 			type_iterable m_bases;
+			const type_id_t* m_ancestors = nullptr;
+			size_t m_ancestor_count = 0;
+			const base_cast* m_base_casts = nullptr;
 			constructor_iterable m_constructors;
 			property_iterable m_properties;
 			method_iterable m_methods;
 			attribute_iterable m_attributes;
-			value(*m_constructor)(arguments) = nullptr;
+			const container_view* m_container = nullptr;
+			enumerator_iterable m_enumerators;
+			value(*m_constructor)(std::pmr::memory_resource*, arguments) = nullptr;
+			bool(*m_placement_constructor)(void*, size_t, arguments) = nullptr;
+			void(*m_destructor)(void*, size_t) = nullptr;
+			size_t	m_size = 0;
+			size_t	m_alignment = 0;
 			bool	m_has_description = false;
 			bool	m_is_const = false;
 			bool	m_is_volatile = false;
 			bool	m_is_reference = false;
 			bool	m_is_pointer = false;
+			bool	m_is_enum = false;
+			bool	m_is_trivially_copyable = false;
+			bool	m_is_integral = false;
+			bool	m_is_floating_point = false;
+			bool	m_is_signed = false;
 			size_t	m_rank = 0;
 			const type_view& (*m_decay_type)();
 			const type_view& (*m_unconst_type)();
@@ -1456,57 +3646,293 @@ namespace rtti
 		{
 			return m_view_getter();
 		}
+		inline const type_view& property_view::object_type() const
+		{
+			return m_object_view_getter();
+		}
 
+		inline type_id_t get_signature_id(arguments args)
+		{
+			type_id_t result = signature_seed;
+			for (auto& arg : args)
+				result = combine_signature_id(result, arg.type().id());
+			return result;
+		}
+
+		inline bool method_view::resolve_object(void*& object, const type_view& type, bool is_const) const
+		{
+			auto& object_type = m_object_type();
+			if (object_type.is<void>())
+				return true;
+			if (is_const && !m_is_const)
+				return false;
+			object = upcast(object, type, object_type);
+			return object != nullptr;
+		}
+
+		template<typename R, typename... Args>
+		inline bound_method<R(Args...)>::bound_method(const method_view& method)
+		{
+			if (method.is_invocable_as<R, Args...>())
+			{
+				m_method = &method;
+				m_is_member = !method.object_type().is<void>();
+			}
+		}
+
+		inline const type_view& value_ref::type() const
+		{
+			if (m_type)
+				return *m_type;
+			return get_type_view<void>();
+		}
+
+		inline value value_ref::pointer() const
+		{
+			value result;
+			if (m_type)
+				result.assign_pointer(m_is_const ? m_type->const_type().once_pointer_type() : m_type->once_pointer_type(), m_address);
+			return result;
+		}
+
+		// Types are linked while other threads may walk the chain, as type_registry does for late registered types.
+		// Links are published with release stores and read with acquire loads, and count() is raised after linking.
 		class type_view_chain : noncopyable
 		{
 		public:
 			type_view_chain(const type_view& r)
 				: m_type_view(r)
 			{
-				if (sm_root == nullptr)
-					sm_root = this;
-				if(sm_tail != nullptr)
-					sm_tail->m_next = this;
+				std::lock_guard<std::mutex> lock(link_mutex());
+				if (sm_tail == nullptr)
+					sm_root.store(this, std::memory_order_release);
+				else
+					sm_tail->m_next.store(this, std::memory_order_release);
 				sm_tail = this;
+				++sm_count;
 			}
 
 			const type_view& view() const { return m_type_view; }
-			const type_view_chain* next() const { return m_next; }
-			static const type_view_chain* root() { return sm_root; }
+			const type_view_chain* next() const { return m_next.load(std::memory_order_acquire); }
+			static const type_view_chain* root() { return sm_root.load(std::memory_order_acquire); }
+			static size_t count() { return sm_count; }
 		private:
 			const type_view&	m_type_view;
-			type_view_chain*	m_next;
-			inline static type_view_chain*	sm_root;
+			// Chains are const objects, which are linked to the next one after their construction.
+			mutable std::atomic<type_view_chain*>	m_next = { nullptr };
+			inline static std::atomic<type_view_chain*>	sm_root;
 			inline static type_view_chain*	sm_tail;
-		};
+			inline static std::atomic<size_t>	sm_count;
 
-		template<typename C> struct meta {};
+			// Chains are constructed during static initialization, so the mutex is initialized on first use.
+			static std::mutex& link_mutex()
+			{
+				static std::mutex mutex;
+				return mutex;
+			}
+		};
 
-		template<typename C>
-		class type_impl
+		// Open addressing hash table from type id to type_view.
+		class type_id_table
 		{
 		public:
-			using target_type = C;
-			using decay_type = std::decay_t<C>;
-			using const_type = std::add_const_t<C>;
-			using unconst_type = std::remove_const_t<C>;
-			using unpointer_type = std::remove_pointer_t<C>;
+			// Keeps the first view when the id is already registered.
+			void insert(type_id_t id, const type_view& view)
+			{
+				if ((m_size + 1) * 2 > m_slots.size())
+					rehash(m_slots.empty() ? 16 : m_slots.size() * 2);
+
+				auto& slot = probe(id);
+				if (slot.view == nullptr)
+				{
+					slot = { id, &view };
+					++m_size;
+				}
+			}
+
+			const type_view* find(type_id_t id) const
+			{
+				if (m_slots.empty())
+					return nullptr;
+				return const_cast<type_id_table*>(this)->probe(id).view;
+			}
+
+			size_t size() const { return m_size; }
+
+		private:
+			struct slot
+			{
+				type_id_t			id;
+				const type_view*	view;
+			};
+
+			std::vector<slot>	m_slots;
+			size_t				m_size = 0;
+
+			slot& probe(type_id_t id)
+			{
+				// Type ids are weak string hashes, spread them before masking.
+				auto mask = m_slots.size() - 1;
+				auto i = (size_t)((id * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+				while (m_slots[i].view != nullptr && m_slots[i].id != id)
+					i = (i + 1) & mask;
+				return m_slots[i];
+			}
+
+			void rehash(size_t capacity)
+			{
+				std::vector<slot> slots(capacity, slot{ 0, nullptr });
+				std::swap(m_slots, slots);
+				for (auto& s : slots)
+				{
+					if (s.view)
+						probe(s.id) = s;
+				}
+			}
+		};
+
+		// Index of all types registered to type_view_chain, built on first use.
+		// Types registered after that are added to a copy of the table on the first miss, which replaces it,
+		// so lookups never lock or walk the chain.
+		class type_registry : noncopyable
+		{
+		public:
+			static const type_registry& instance()
+			{
+				static const type_registry registry;
+				return registry;
+			}
+
+			const type_view* find(type_id_t id) const
+			{
+				auto current = m_current.load(std::memory_order_acquire);
+				if (auto view = current->table.find(id))
+					return view;
+				if (type_view_chain::count() != current->count)
+					return update()->table.find(id);
+				return nullptr;
+			}
+
+			inline const type_view* find(std::string_view name) const;
+
+			size_t size() const { return m_current.load(std::memory_order_acquire)->table.size(); }
+
+		private:
+			struct snapshot
+			{
+				type_id_table			table;
+				const type_view_chain*	last = nullptr;		// the last chain in the table
+				size_t					count = 0;
+			};
+
+			mutable std::mutex	m_mutex;
+			// Replaced tables are kept, as other threads may still be reading them.
+			mutable std::vector<std::unique_ptr<snapshot>>	m_snapshots;
+			mutable std::atomic<const snapshot*>	m_current = { nullptr };
+
+			type_registry()
+			{
+				update();
+			}
+
+			const snapshot* update() const
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				auto current = m_current.load(std::memory_order_relaxed);
+				if (current && current->count == type_view_chain::count())
+					return current;
+
+				auto next = current ? std::make_unique<snapshot>(*current) : std::make_unique<snapshot>();
+				for (auto chain = next->last ? next->last->next() : type_view_chain::root(); chain; chain = chain->next())
+				{
+					next->table.insert(chain->view().id(), chain->view());
+					next->last = chain;
+					++next->count;
+				}
+				m_snapshots.push_back(std::move(next));
+				m_current.store(m_snapshots.back().get(), std::memory_order_release);
+				return m_snapshots.back().get();
+			}
+		};
+
+		inline const type_view* type_registry::find(std::string_view name) const
+		{
+			auto view = find(hash(name));
+			return view && view->name() == name ? view : nullptr;
+		}
+
+		template<typename C> struct meta {};
+		template<typename C> struct ancestor_table;
+		template<typename C> struct base_cast_table;
+
+		template<typename C>
+		class type_impl
+		{
+		public:
+			using target_type = C;
+			using decay_type = std::decay_t<C>;
+			using const_type = std::add_const_t<C>;
+			using unconst_type = std::remove_const_t<C>;
+			using unpointer_type = std::remove_pointer_t<C>;
 			using once_pointer_type = std::conditional_t<std::is_pointer_v<C>, C, std::add_pointer_t<C>>;
 
 			static constexpr std::string_view name() { return get_type_name<C>(); }
 			static constexpr std::string_view display_name() { return name(); }
+			using base_list = type_list<>;
 			static constexpr type_array<> bases() { return {}; }
+			static constexpr const auto& ancestors() { return ancestor_table<C>::value; }
+			static constexpr const base_cast* base_casts() { return base_cast_table<C>::data(); }
 			static constexpr constructor_array<> constructors() { return {}; }
 			static constexpr property_array<> properties() { return {}; }
 			static constexpr method_array<> methods() { return {}; }
 			static constexpr attribute_array<> attributes() { return {}; }
+			static constexpr const container_view* container()
+			{
+				if constexpr (is_container<std::remove_cv_t<C>>::value)
+					return &container_view_instance<std::remove_cv_t<C>>;
+				else
+					return nullptr;
+			}
+			static constexpr enumerator_iterable enumerators() { return {}; }
 			static constexpr type_id_t id() { return get_type_id<C>(); }
 			static constexpr bool is_const() { return std::is_const_v<C>;  }
 			static constexpr bool is_volatile() { return std::is_volatile_v<C>; }
 			static constexpr bool is_reference() { return std::is_reference_v<C>; }
 			static constexpr bool is_pointer() { return std::is_pointer_v<C>; }
+			static constexpr bool is_enum() { return std::is_enum_v<C>; }
+			static constexpr bool is_trivially_copyable() { return std::is_trivially_copyable_v<C>; }
+			static constexpr bool is_integral() { return std::is_integral_v<C>; }
+			static constexpr bool is_floating_point() { return std::is_floating_point_v<C>; }
+			static constexpr bool is_signed()
+			{
+				if constexpr (std::is_enum_v<C>)
+					return std::is_signed_v<std::underlying_type_t<C>>;
+				else
+					return std::is_signed_v<C>;
+			}
 			static constexpr size_t rank() { return std::rank_v<C>; }
-			static value instantiate(arguments) { return {}; }
+			static value instantiate(std::pmr::memory_resource*, arguments) { return {}; }
+			static bool instantiate_at(void*, size_t, arguments) { return false; }
+			static void destroy(void* objects, size_t count)
+			{
+				using object_type = std::remove_cv_t<C>;
+				if constexpr (std::is_object_v<object_type> && !std::is_array_v<object_type> && std::is_destructible_v<object_type>)
+					std::destroy_n(static_cast<object_type*>(objects), count);
+			}
+			static constexpr size_t size()
+			{
+				if constexpr (std::is_object_v<C>)
+					return sizeof(C);
+				else
+					return 0;
+			}
+			static constexpr size_t alignment()
+			{
+				if constexpr (std::is_object_v<C>)
+					return alignof(C);
+				else
+					return 0;
+			}
 		};
 		template<typename C, typename = void>
 		class type : public type_impl<C>
@@ -1520,13 +3946,16 @@ namespace rtti
 		public:
 			using meta_type = meta<std::remove_cv_t<C>>;
 			static constexpr std::string_view display_name() { return meta_type::description.display_name(); }
+			using base_list = typename std::remove_const_t<decltype(meta_type::description)>::base_list;
 			static constexpr auto& bases() { return meta_type::description.bases(); }
 			static constexpr auto& constructors() { return meta_type::description.constructors(); }
 			static constexpr auto& properties() { return meta_type::description.properties(); }
 			static constexpr auto& methods() { return meta_type::description.methods(); }
 			static constexpr auto& attributes() { return meta_type::description.attributes(); }
+			static constexpr enumerator_iterable enumerators() { return meta_type::description.enumerators(); }
 			static constexpr bool has_description() { return true; }
-			static value instantiate(arguments args) { return meta_type::description.instantiate(args); }
+			static value instantiate(std::pmr::memory_resource* resource, arguments args) { return meta_type::description.instantiate(resource, args); }
+			static bool instantiate_at(void* storage, size_t count, arguments args) { return meta_type::description.instantiate_at(storage, count, args); }
 		};
 
 		template<typename C, typename Bases = type_list<>, typename Constructors = type_list<>, typename Properties = type_list<>, typename Methods = type_list<>, typename Attributes = type_list<>>
@@ -1535,6 +3964,7 @@ namespace rtti
 			static_assert(std::is_same_v<C, std::remove_cv_t<std::decay_t<C>>>, "typename C must not have qualifier.");
 		public:
 			template<typename... Args> using type_constructor_array = constructor_array<C, Args...>;
+			using base_list = Bases;
 			using base_set = typename Bases::template expand<type_array>;
 			using constructor_set = typename Constructors::template expand<type_constructor_array>;
 			using property_set = typename Properties::template expand<property_array>;
@@ -1591,202 +4021,3367 @@ namespace rtti
 				>(m_display_name, m_constructors, all_properties, all_methods, all_attributes);
 			}
 
-			constexpr auto display_name(std::string_view display_name) const
+			constexpr auto display_name(std::string_view display_name) const
+			{
+				return meta_description<C, Bases, Constructors, Properties, Methods, Attributes>(display_name, m_constructors, m_properties, m_methods, m_attributes);
+			}
+
+			template<typename ...Args>
+			constexpr auto constructors(Args&&... args) const
+			{
+				auto all = type_constructor_array<Args...>{ std::forward<Args>(args)... };
+				return meta_description<C, Bases, typename decltype(all)::instance_value_type, Properties, Methods, Attributes>(m_display_name, all, m_properties, m_methods, m_attributes);
+			}
+
+			template<typename... Args>
+			constexpr auto properties(Args&&... args) const
+			{
+				auto all = concat_array(m_properties, property_array{ std::forward<Args>(args)... });
+				return meta_description<C, Bases, Constructors, typename decltype(all)::instance_value_type, Methods, Attributes>(m_display_name, m_constructors, all, m_methods, m_attributes);
+			}
+
+			template<typename... Args>
+			constexpr auto methods(Args&&... args) const
+			{
+				auto all = concat_array(m_methods, method_array{ std::forward<Args>(args)... });
+				return meta_description<C, Bases, Constructors, Properties, typename decltype(all)::instance_value_type, Attributes>(m_display_name, m_constructors, m_properties, all, m_attributes);
+			}
+
+			template<typename... Args>
+			constexpr auto attributes(Args&&... args) const
+			{
+				auto all = concat_array(m_attributes, attribute_array{ std::forward<Args>(args)... });
+				return meta_description<C, Bases, Constructors, Properties, Methods, typename decltype(all)::instance_value_type>(m_display_name, m_constructors, m_properties, m_methods, all);
+			}
+
+			constexpr std::string_view display_name() const { return m_display_name; }
+			constexpr const base_set& bases() const { return m_bases; }
+			constexpr const constructor_set& constructors() const { return m_constructors; }
+			constexpr const property_set& properties() const { return m_properties; }
+			constexpr const method_set& methods() const { return m_methods; }
+			constexpr const attribute_set& attributes() const { return m_attributes; }
+			constexpr enumerator_iterable enumerators() const { return {}; }
+			value instantiate(std::pmr::memory_resource* resource, arguments args) const { return m_constructors.instantiate(resource, args); }
+			bool instantiate_at(void* storage, size_t count, arguments args) const { return m_constructors.instantiate_at(storage, count, args); }
+		private:
+			std::string_view				m_display_name;
+			base_set						m_bases;
+			constructor_set					m_constructors;
+			property_set					m_properties;
+			method_set						m_methods;
+			attribute_set					m_attributes;
+
+		protected:
+
+			template<typename Type, typename... Types>
+			static constexpr auto gather_properties(Type t, Types... types)
+			{
+				return concat_array(t.properties(), gather_properties(types...));
+			}
+			static constexpr auto gather_properties()
+			{
+				return property_set{};
+			}
+
+			template<typename Type, typename... Types>
+			static constexpr auto gather_methods(Type t, Types... types)
+			{
+				return concat_array(t.methods(), gather_methods(types...));
+			}
+			static constexpr auto gather_methods()
+			{
+				return method_set{};
+			}
+
+			template<typename Type, typename... Types>
+			static constexpr auto gather_attributes(Type t, Types... types)
+			{
+				return concat_array(t.attributes(), gather_attributes(types...));
+			}
+			static constexpr auto gather_attributes()
+			{
+				return attribute_set{};
+			}
+		};
+
+		// Description of an enum built by rtti_enum_impl, which has no members but the enumerators.
+		template<typename E, size_t Size = 0>
+		class enum_description
+		{
+			static_assert(std::is_enum_v<E>, "typename E must be an enum.");
+		public:
+			using base_list = type_list<>;
+
+			constexpr enum_description(std::string_view display_name, const enumerator_array<Size>& enumerators)
+				: m_display_name(display_name)
+				, m_enumerators(enumerators)
+			{}
+
+			static constexpr auto initialize(std::string_view name)
+			{
+				return enum_description<E>(name, {});
+			}
+
+			constexpr auto display_name(std::string_view display_name) const
+			{
+				return enum_description<E, Size>(display_name, m_enumerators);
+			}
+
+			template<typename... Args>
+			constexpr auto enumerators(const enumerator<Args>&... args) const
+			{
+				static_assert(Size == 0);
+				static_assert((std::is_same_v<E, Args> && ...), "enumerators must be of the described enum.");
+				return enum_description<E, sizeof...(Args)>(m_display_name, enumerator_array<sizeof...(Args)>(args...));
+			}
+
+			constexpr std::string_view display_name() const { return m_display_name; }
+			constexpr const type_array<>& bases() const { return m_bases; }
+			constexpr const constructor_array<E>& constructors() const { return m_constructors; }
+			constexpr const property_array<>& properties() const { return m_properties; }
+			constexpr const method_array<>& methods() const { return m_methods; }
+			constexpr const attribute_array<>& attributes() const { return m_attributes; }
+			constexpr enumerator_iterable enumerators() const { return m_enumerators.iterable(); }
+			value instantiate(std::pmr::memory_resource* resource, arguments args) const { return m_constructors.instantiate(resource, args); }
+			bool instantiate_at(void* storage, size_t count, arguments args) const { return m_constructors.instantiate_at(storage, count, args); }
+		private:
+			std::string_view				m_display_name;
+			type_array<>					m_bases;
+			constructor_array<E>			m_constructors;
+			property_array<>				m_properties;
+			method_array<>					m_methods;
+			attribute_array<>				m_attributes;
+			enumerator_array<Size>			m_enumerators;
+		};
+
+		template<size_t Capacity>
+		struct ancestor_array
+		{
+			std::array<type_id_t, Capacity>	ids;
+			size_t							size;
+
+			constexpr const type_id_t* data() const
+			{
+				if constexpr (Capacity == 0)
+					return nullptr;
+				else
+					return ids.data();
+			}
+
+			// Inserts keeping ids sorted and unique.
+			constexpr void insert(type_id_t id)
+			{
+				for (size_t i = 0; i < size; ++i)
+				{
+					if (ids[i] == id)
+						return;
+				}
+				auto i = size++;
+				for (; i > 0 && ids[i - 1] > id; --i)
+					ids[i] = ids[i - 1];
+				ids[i] = id;
+			}
+		};
+
+		// Flattened bases of C computed at compile time.
+		template<typename C>
+		struct ancestor_table
+		{
+		private:
+			template<typename... Bases>
+			static constexpr size_t capacity(type_list<Bases...>)
+			{
+				return (size_t(0) + ... + (1 + ancestor_table<Bases>::value.ids.size()));
+			}
+
+			template<typename Base, size_t Capacity>
+			static constexpr void append(ancestor_array<Capacity>& result)
+			{
+				result.insert(get_type_id<Base>());
+				for (size_t i = 0; i < ancestor_table<Base>::value.size; ++i)
+					result.insert(ancestor_table<Base>::value.ids[i]);
+			}
+
+			template<typename... Bases>
+			static constexpr auto gather(type_list<Bases...>)
+			{
+				ancestor_array<capacity(type_list<Bases...>())> result{};
+				(append<Bases>(result), ...);
+				return result;
+			}
+
+		public:
+			static constexpr auto value = gather(typename type<C>::base_list());
+		};
+
+		// Upcasts of C to its direct bases.
+		template<typename C>
+		struct base_cast_table
+		{
+		private:
+			template<typename... Bases>
+			static constexpr auto gather(type_list<Bases...>)
+			{
+				using derived_type = std::remove_cv_t<C>;
+				return std::array<base_cast, sizeof...(Bases)>{ base_cast{ &upcast_object<derived_type, Bases>, is_virtual_base_of<Bases, derived_type>::value }... };
+			}
+
+		public:
+			static constexpr auto value = gather(typename type<C>::base_list());
+
+			static constexpr const base_cast* data()
+			{
+				if constexpr (value.size() == 0)
+					return nullptr;
+				else
+					return value.data();
+			}
+		};
+
+		template<typename T>
+		inline const type_view type_view_instance = { type<T>() };
+
+		template<typename T>
+		inline const type_view& get_type_view()
+		{
+			return type_view_instance<T>;
+		}
+
+		inline const type_view& get_type_view_once_pointer(const type_view& type)
+		{
+			return type.once_pointer_type();
+		}
+		inline const type_view& get_type_view_const(const type_view& type)
+		{
+			return type.const_type();
+		}
+
+		template<typename T> 
+		const T* value_cast(const value& v)
+		{
+			static_assert(!std::is_reference_v<T>);
+
+			if (!v.has_value())
+				return nullptr;
+
+			if (v.type() == get_type_view<T>())
+				return reinterpret_cast<T*>(v.buffer_address());
+
+			if constexpr (std::is_pointer_v<T> && std::is_const_v<std::remove_pointer_t<T>>)
+			{
+				using attempt_type = std::remove_const_t<std::remove_pointer_t<T>>*;
+				if (v.type() == get_type_view<attempt_type>())
+					return reinterpret_cast<attempt_type*>(v.buffer_address());
+			}
+			
+			return nullptr;
+		}
+
+		template<typename T>
+		const T* value_cast(const value_ref& v)
+		{
+			static_assert(!std::is_reference_v<T>);
+
+			if (!v.has_value())
+				return nullptr;
+
+			if (v.type().unconst_type() == get_type_view<std::remove_const_t<T>>())
+				return reinterpret_cast<const T*>(v.m_address);
+
+			if constexpr (std::is_pointer_v<T> && std::is_const_v<std::remove_pointer_t<T>>)
+			{
+				using attempt_type = std::remove_const_t<std::remove_pointer_t<T>>*;
+				if (v.type().unconst_type() == get_type_view<attempt_type>())
+					return reinterpret_cast<const attempt_type*>(v.m_address);
+			}
+
+			return nullptr;
+		}
+
+		template<typename To> To* object_cast(void* ptr, const type_view& from_type);
+		template<typename T> T* cast_object(const type_view& type, void* address, bool is_mutable)
+		{
+			using value_type = std::remove_const_t<T>;
+			constexpr bool is_void = std::is_void_v<value_type>;
+
+			if (type.is_pointer())
+			{
+				if (!type.unpointer_type().is_const() || std::is_const_v<T>)
+				{
+					if constexpr (is_void)
+						return *reinterpret_cast<void**>(address);
+					else
+						return object_cast<value_type>(
+							*reinterpret_cast<void**>(address), type.unpointer_type().unconst_type());
+				}
+			}
+			else if (is_mutable || std::is_const_v<T>)
+			{
+				if constexpr (is_void)
+					return address;
+				else
+					return object_cast<value_type>(address, type.unconst_type());
+			}
+
+			return nullptr;
+		}
+
+		template<typename T> T* value_cast_object(const value& v)
+		{
+			static_assert(std::is_class_v<T> || std::is_void_v<T>);
+
+			if (!v.has_value())
+				return nullptr;
+
+			// If value has a instanced T, return the address of storage whitch it has directly.
+			// This case are allowed when T has const qualifer.
+			return cast_object<T>(v.type(), v.buffer_address(), false);
+		}
+
+		template<typename T> T* value_cast_object(const value_ref& v)
+		{
+			static_assert(std::is_class_v<T> || std::is_void_v<T>);
+
+			if (!v.has_value())
+				return nullptr;
+
+			return cast_object<T>(v.type(), v.m_address, !v.is_const());
+		}
+
+		inline bool is_base_of(const type_view& base_type, const type_view& derived_type)
+		{
+			auto id = base_type.id();
+			if (id == derived_type.id())
+				return true;
+
+			auto ancestors = derived_type.ancestors();
+			return std::binary_search(ancestors.begin(), ancestors.end(), id);
+		}
+
+		template<typename Base>
+		inline bool is_base_of(const type_view& derived_type)
+		{
+			return is_base_of(get_type_view<std::decay_t<Base>>(), derived_type);
+		}
+
+		// Per thread cache of base subobject offsets.
+		// Paths through a virtual base are not cached since the offset depends on the most derived type.
+		class base_offset_cache
+		{
+		public:
+			static bool find(type_id_t from, type_id_t to, ptrdiff_t& offset)
+			{
+				auto& e = sm_entries[slot(from, to)];
+				if (!e.is_valid || e.from != from || e.to != to)
+					return false;
+				offset = e.offset;
+				return true;
+			}
+
+			static void insert(type_id_t from, type_id_t to, ptrdiff_t offset)
+			{
+				sm_entries[slot(from, to)] = { from, to, offset, true };
+			}
+
+		private:
+			struct entry
+			{
+				type_id_t	from;
+				type_id_t	to;
+				ptrdiff_t	offset;
+				bool		is_valid;
+			};
+			static constexpr size_t capacity = 256;
+
+			inline static thread_local std::array<entry, capacity> sm_entries = {};
+
+			static size_t slot(type_id_t from, type_id_t to)
+			{
+				return (size_t)(((from ^ (to << 1)) * 0x9E3779B97F4A7C15ULL) >> 32) & (capacity - 1);
+			}
+		};
+
+		inline void* upcast_path(void* object, const type_view& from_type, const type_view& to_type, bool& is_fixed)
+		{
+			if (from_type == to_type)
+				return object;
+
+			auto cast = from_type.base_casts().begin();
+			for (auto& base : from_type.bases())
+			{
+				if (is_base_of(to_type, base))
+				{
+					if (cast->is_virtual)
+						is_fixed = false;
+					return upcast_path(cast->upcast(object), base, to_type, is_fixed);
+				}
+				++cast;
+			}
+			return nullptr;
+		}
+
+		// Adjusts the address of a from_type object to its to_type subobject.
+		// Returns nullptr if to_type is not from_type or a base of it.
+		inline void* upcast(void* object, const type_view& from_type, const type_view& to_type)
+		{
+			if (object == nullptr)
+				return nullptr;
+			if (from_type == to_type)
+				return object;
+
+			ptrdiff_t offset;
+			if (base_offset_cache::find(from_type.id(), to_type.id(), offset))
+				return static_cast<char*>(object) + offset;
+
+			if (!is_base_of(to_type, from_type))
+				return nullptr;
+
+			bool is_fixed = true;
+			auto result = upcast_path(object, from_type, to_type, is_fixed);
+			if (result && is_fixed)
+				base_offset_cache::insert(from_type.id(), to_type.id(), static_cast<char*>(result) - static_cast<char*>(object));
+			return result;
+		}
+
+		// Offset of the to_type subobject in from_type, taken by upcasting the probe address.
+		// Returns false when the path passes a virtual base, whose offset depends on the most derived type.
+		inline bool base_offset(const type_view& from_type, const type_view& to_type, void* probe, ptrdiff_t& offset)
+		{
+			auto address = probe;
+			auto type = &from_type;
+			while (*type != to_type)
+			{
+				auto cast = type->base_casts().begin();
+				const type_view* next = nullptr;
+				for (auto& base : type->bases())
+				{
+					if (is_base_of(to_type, base))
+					{
+						next = &base;
+						break;
+					}
+					++cast;
+				}
+				if (next == nullptr || cast->is_virtual)
+					return false;
+
+				address = cast->upcast(address);
+				type = next;
+			}
+			offset = static_cast<char*>(address) - static_cast<char*>(probe);
+			return true;
+		}
+
+		inline void* object_address(const value& object, const type_view& to_type, bool is_mutable)
+		{
+			if (!object.has_value())
+				return nullptr;
+
+			auto& type = object.type();
+			auto& object_type = type.is_pointer() ? type.unpointer_type().unconst_type() : type.unconst_type();
+			auto address = is_mutable ? value_cast_object<void>(object) : const_cast<void*>(value_cast_object<const void>(object));
+			return upcast(address, object_type, to_type);
+		}
+
+		template<typename To>
+		inline To* object_cast(void* ptr, const type_view& from_type)
+		{
+			return static_cast<To*>(upcast(ptr, from_type, get_type_view<std::remove_const_t<To>>()));
+		}
+
+		template<typename To, typename From>
+		inline To* object_cast(From* object)
+		{
+			if constexpr (std::is_convertible_v<From*, To*>)
+				return static_cast<To*>(object);
+			else
+				return object_cast<To>(get_object_address(*object), object->rtti_type_view());
+		}
+
+		// Typed accessor of a property resolved once for objects of T.
+		// Reads and writes plain members with a direct load and store, others through the property without boxing.
+		template<typename T, typename V>
+		class property_handle
+		{
+			static_assert(std::is_class_v<T> && !std::is_const_v<T>);
+		public:
+			property_handle()
+			{}
+			explicit property_handle(const property_view& property)
+			{
+				auto& object_type = get_type_view<T>();
+				if (property.value_type() != get_type_view<V>() || property.rank() != 0 || !is_base_of(property.object_type(), object_type))
+					return;
+
+				m_property = &property;
+				m_object_type = &property.object_type();
+				m_is_read_only = property.is_read_only();
+
+				alignas(T) unsigned char probe[sizeof(T)];
+				m_is_fixed = base_offset(object_type, *m_object_type, probe, m_offset);
+				if (m_is_fixed && property.offset() >= 0)
+				{
+					m_offset += property.offset();
+					m_is_direct = true;
+				}
+			}
+
+			bool has_value() const { return m_property; }
+			explicit operator bool() const { return has_value(); }
+			// True when the value is accessed by the byte offset in T.
+			bool is_direct() const { return m_is_direct; }
+
+			// Returns V{} when the value can not be read, which get(object, value) reports.
+			V get(const T& object) const
+			{
+				if (m_is_direct)
+					return *reinterpret_cast<const V*>(reinterpret_cast<const char*>(&object) + m_offset);
+
+				V result{};
+				get(object, result);
+				return result;
+			}
+			// Returns false and leaves value unchanged when V can not be copy assigned.
+			bool get(const T& object, V& value) const
+			{
+				if (m_is_direct)
+				{
+					if constexpr (std::is_copy_assignable_v<V>)
+					{
+						value = *reinterpret_cast<const V*>(reinterpret_cast<const char*>(&object) + m_offset);
+						return true;
+					}
+					else
+						return false;
+				}
+				return m_property->read(object_address(const_cast<T&>(object)), &value);
+			}
+			// Returns false when the property is read only, or V can not be copy assigned.
+			bool set(T& object, const V& value) const
+			{
+				if (m_is_read_only)
+					return false;
+
+				if constexpr (std::is_copy_assignable_v<V>)
+				{
+					if (m_is_direct)
+					{
+						*reinterpret_cast<V*>(reinterpret_cast<char*>(&object) + m_offset) = value;
+						return true;
+					}
+				}
+				return m_property->write(object_address(object), &value);
+			}
+
+		private:
+			const property_view*	m_property = nullptr;
+			const type_view*		m_object_type = nullptr;
+			ptrdiff_t				m_offset = 0;
+			bool					m_is_fixed = false;
+			bool					m_is_direct = false;
+			bool					m_is_read_only = false;
+
+			void* object_address(T& object) const
+			{
+				if (m_is_fixed)
+					return reinterpret_cast<char*>(&object) + m_offset;
+				return upcast(&object, get_type_view<T>(), *m_object_type);
+			}
+		};
+
+		// Slab allocator for objects of one reflected type, sized by type_view::size() and alignment().
+		// Each thread keeps a small cache of free slots, so threads allocate concurrently and lock only to exchange slots in batches.
+		// The slots cached by a thread return to the pool when the thread exits. Objects must be destroyed before the pool.
+		class object_pool : noncopyable
+		{
+		public:
+			static constexpr size_t default_slab_capacity = 64;
+
+			struct statistics
+			{
+				size_t	slab_count = 0;
+				size_t	capacity = 0;
+				size_t	live_count = 0;
+			};
+
+			explicit object_pool(const type_view& type, size_t slab_capacity = default_slab_capacity, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+				: m_type(type)
+				, m_upstream(upstream)
+				, m_slab_capacity(slab_capacity ? slab_capacity : 1)
+				, m_alignment(std::max(type.alignment(), alignof(void*)))
+				, m_stride((std::max(type.size(), sizeof(void*)) + m_alignment - 1) / m_alignment * m_alignment)
+				, m_id(++sm_last_id)
+			{
+				std::lock_guard<std::mutex> lock(live_pools_mutex());
+				live_pools()[m_id] = this;
+			}
+			~object_pool()
+			{
+				{
+					std::lock_guard<std::mutex> lock(live_pools_mutex());
+					live_pools().erase(m_id);
+				}
+				for (auto slab : m_slabs)
+					m_upstream->deallocate(slab, m_stride * m_slab_capacity, m_alignment);
+			}
+
+			// The pool shared by the process for the type.
+			static object_pool& of(const type_view& type)
+			{
+				// The registry of live pools is built first, so it outlives the pools below.
+				live_pools();
+				static std::mutex mutex;
+				static std::unordered_map<type_id_t, std::unique_ptr<object_pool>> pools;
+
+				std::lock_guard<std::mutex> lock(mutex);
+				auto& pool = pools[type.id()];
+				if (!pool)
+					pool = std::make_unique<object_pool>(type);
+				return *pool;
+			}
+
+			const type_view& type() const { return m_type; }
+
+			// Constructs an object in a slot of the pool.
+			// Returns an empty reference when no constructor matches args. The slot is returned also when the constructor throws.
+			value_ref create(arguments args)
+			{
+				struct slot_rollback
+				{
+					object_pool*	pool;
+					void*			slot;
+
+					~slot_rollback()
+					{
+						if (slot)
+							pool->deallocate(slot);
+					}
+				};
+
+				slot_rollback taken = { this, allocate() };
+				auto object = m_type.instantiate_at(taken.slot, args);
+				if (object.has_value())
+					taken.slot = nullptr;
+				return object;
+			}
+			void destroy(void* object)
+			{
+				m_type.destroy(object);
+				deallocate(object);
+			}
+
+			// Uninitialized slot for one object.
+			void* allocate()
+			{
+				auto& local = local_cache();
+				if (local.count == 0)
+					refill(local);
+				local.add_live(1);
+				return local.slots[--local.count];
+			}
+			void deallocate(void* slot)
+			{
+				auto& local = local_cache();
+				if (local.count == cache_capacity)
+					flush(local);
+				local.add_live(-1);
+				local.slots[local.count++] = slot;
+			}
+
+			statistics stats() const
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				ptrdiff_t live = m_retired_live;
+				for (auto& c : m_caches)
+					live += c->live.load(std::memory_order_relaxed);
+				return { m_slabs.size(), m_slabs.size() * m_slab_capacity, (size_t)live };
+			}
+
+		private:
+			static constexpr size_t cache_capacity = 32;
+
+			struct free_slot
+			{
+				free_slot*	next;
+			};
+
+			struct cache
+			{
+				std::array<void*, cache_capacity>	slots;
+				size_t								count = 0;
+				// Written only by the owner thread, so the update needs no read-modify-write.
+				std::atomic<ptrdiff_t>				live = 0;
+
+				void add_live(ptrdiff_t n)
+				{
+					live.store(live.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+				}
+			};
+
+			const type_view&					m_type;
+			std::pmr::memory_resource*			m_upstream;
+			size_t								m_slab_capacity;
+			size_t								m_alignment;
+			size_t								m_stride;
+			uint64_t							m_id;
+			mutable std::mutex					m_mutex;
+			std::vector<void*>					m_slabs;
+			std::vector<std::unique_ptr<cache>>	m_caches;
+			ptrdiff_t							m_retired_live = 0;	// of the caches of exited threads
+			free_slot*							m_free = nullptr;
+
+			inline static std::atomic<uint64_t>	sm_last_id = 0;
+
+			// Caches of the pools used by a thread, found by pool id. Ids are never reused, so an entry of a destroyed pool never matches.
+			// Recent pools are found in a direct mapped table, others in a map, so pools which share a slot do not take the lock.
+			class thread_caches : noncopyable
+			{
+			public:
+				thread_caches()
+				{}
+				// Returns the slots to the pools which are still alive.
+				~thread_caches()
+				{
+					std::lock_guard<std::mutex> lock(live_pools_mutex());
+					auto& pools = live_pools();
+					for (auto& e : m_entries)
+					{
+						auto pool = pools.find(e.first);
+						if (pool != pools.end())
+							pool->second->retire(*e.second);
+					}
+				}
+
+				cache* find(uint64_t id)
+				{
+					auto& recent = m_recent[id % m_recent.size()];
+					if (recent.id == id)
+						return recent.local;
+					auto e = m_entries.find(id);
+					if (e == m_entries.end())
+						return nullptr;
+					recent = { id, e->second };
+					return e->second;
+				}
+
+				void insert(uint64_t id, cache* local)
+				{
+					if (m_entries.size() >= m_prune_size)
+						prune();
+					m_entries[id] = local;
+					m_recent[id % m_recent.size()] = { id, local };
+				}
+
+			private:
+				struct entry
+				{
+					uint64_t	id;
+					cache*		local;
+				};
+
+				std::array<entry, 8>					m_recent = {};
+				std::unordered_map<uint64_t, cache*>	m_entries;
+				size_t									m_prune_size = 16;
+
+				// Drops the entries of destroyed pools.
+				void prune()
+				{
+					{
+						std::lock_guard<std::mutex> lock(live_pools_mutex());
+						auto& pools = live_pools();
+						for (auto e = m_entries.begin(); e != m_entries.end();)
+							e = pools.count(e->first) ? std::next(e) : m_entries.erase(e);
+					}
+					m_recent = {};
+					m_prune_size = std::max<size_t>(16, m_entries.size() * 2);
+				}
+			};
+
+			static std::mutex& live_pools_mutex()
+			{
+				static std::mutex mutex;
+				return mutex;
+			}
+			static std::unordered_map<uint64_t, object_pool*>& live_pools()
+			{
+				static std::unordered_map<uint64_t, object_pool*> pools;
+				return pools;
+			}
+
+			cache& local_cache()
+			{
+				thread_local thread_caches caches;
+
+				if (auto local = caches.find(m_id))
+					return *local;
+				auto& local = add_cache();
+				caches.insert(m_id, &local);
+				return local;
+			}
+
+			cache& add_cache()
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_caches.push_back(std::make_unique<cache>());
+				return *m_caches.back();
+			}
+
+			// Takes back the slots and the count of live objects of the cache of an exited thread.
+			void retire(cache& local)
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				while (local.count != 0)
+				{
+					auto slot = static_cast<free_slot*>(local.slots[--local.count]);
+					slot->next = m_free;
+					m_free = slot;
+				}
+				m_retired_live += local.live.load(std::memory_order_relaxed);
+				m_caches.erase(std::find_if(m_caches.begin(), m_caches.end(), [&](auto& c) { return c.get() == &local; }));
+			}
+
+			void refill(cache& local)
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				while (local.count < cache_capacity / 2)
+				{
+					if (m_free == nullptr)
+						grow();
+					local.slots[local.count++] = m_free;
+					m_free = m_free->next;
+				}
+			}
+
+			void flush(cache& local)
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				while (local.count > cache_capacity / 2)
+				{
+					auto slot = static_cast<free_slot*>(local.slots[--local.count]);
+					slot->next = m_free;
+					m_free = slot;
+				}
+			}
+
+			void grow()
+			{
+				auto slab = static_cast<char*>(m_upstream->allocate(m_stride * m_slab_capacity, m_alignment));
+				m_slabs.push_back(slab);
+				for (size_t i = m_slab_capacity; i > 0; --i)
+				{
+					auto slot = reinterpret_cast<free_slot*>(slab + (i - 1) * m_stride);
+					slot->next = m_free;
+					m_free = slot;
+				}
+			}
+		};
+
+		// Data derived from a type by the constructor T(const type_view&), built on first use and shared by the process.
+		// Lookups go through a small thread local cache, so the lock is only taken on a miss.
+		template<typename T>
+		class type_cache
+		{
+		public:
+			static const T& of(const type_view& type)
+			{
+				auto& entry = sm_cache[(size_t)((type.id() * 0x9E3779B97F4A7C15ULL) >> 32) & (cache_capacity - 1)];
+				if (entry.data == nullptr || entry.id != type.id())
+					entry = { type.id(), &find_or_create(type) };
+				return *entry.data;
+			}
+
+		private:
+			struct cache_entry
+			{
+				type_id_t	id;
+				const T*	data;
+			};
+			static constexpr size_t cache_capacity = 64;
+
+			inline static thread_local std::array<cache_entry, cache_capacity> sm_cache = {};
+
+			static const T& find_or_create(const type_view& type)
+			{
+				static std::mutex mutex;
+				static std::unordered_map<type_id_t, std::unique_ptr<T>> entries;
+
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					auto itr = entries.find(type.id());
+					if (itr != entries.end())
+						return *itr->second;
+				}
+				// Built without the lock, so T may look up other types. The first one inserted wins a race.
+				auto data = std::make_unique<T>(type);
+				std::lock_guard<std::mutex> lock(mutex);
+				auto& slot = entries[type.id()];
+				if (!slot)
+					slot = std::move(data);
+				return *slot;
+			}
+		};
+
+		// The subobject of an object which declares a property.
+		struct property_owner
+		{
+			const type_view*	type = nullptr;
+			ptrdiff_t			offset = 0;			// of type in the object when is_fixed
+			bool				is_fixed = true;	// false for a virtual base, which is found by upcast
+		};
+
+		// Finds the owners of the properties of a type, which are passed in the order of type.properties().
+		// Offsets of non-virtual bases are taken on probe storage, as member_offset does.
+		class property_owner_walk : noncopyable
+		{
+		public:
+			explicit property_owner_walk(const type_view& type)
+				: m_type(type)
+				, m_probe((type.size() + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t) + 1)
+			{
+				m_owner.type = &type;
+			}
+
+			const property_owner& next(const property_view& property)
+			{
+				if (property.object_type() != *m_owner.type)
+				{
+					m_owner.type = &property.object_type();
+					m_owner.offset = 0;
+					m_owner.is_fixed = base_offset(m_type, *m_owner.type, m_probe.data(), m_owner.offset);
+				}
+				return m_owner;
+			}
+
+		private:
+			const type_view&				m_type;
+			std::vector<std::max_align_t>	m_probe;
+			property_owner					m_owner;
+		};
+
+		// Reads a property which has no address of its value into a copy of the current value, and assigns it back.
+		// read takes the address of the copy.
+		template<typename Read>
+		inline bool read_property_copy(const property_view& property, const value& pointer, Read&& read)
+		{
+			auto copy = property.get(pointer);
+			if (!copy.has_value() || !read(const_cast<void*>(value_ref(copy).address())))
+				return false;
+			return property.set(pointer, std::move(copy));
+		}
+
+		// Flat list of operations which serializes one type, compiled once from its properties.
+		// Offsets are relative to the object, or to the subobject selected by the last rebase.
+		class serialization_plan : noncopyable
+		{
+		public:
+			enum class opcode : uint8_t
+			{
+				copy,		// size bytes at offset, merged from adjacent trivially copyable members
+				object,		// count objects of type at offset, size bytes apart, by the plan of type
+				container,	// a container of type at offset
+				accessor,	// property of the type subobject at offset, which has no fixed address
+				rebase,		// following offsets are relative to the type subobject, found by upcast
+			};
+
+			struct operation
+			{
+				opcode					code = opcode::copy;
+				bool					is_read_only = false;
+				ptrdiff_t				offset = 0;
+				size_t					size = 0;
+				size_t					count = 0;
+				const type_view*		type = nullptr;
+				const property_view*	property = nullptr;
+			};
+
+			explicit serialization_plan(const type_view& type)
+				: m_type(type)
+			{
+				m_is_valid = compile();
+			}
+
+			// The plan shared by the process for the type, compiled on first use.
+			static const serialization_plan& of(const type_view& type)
+			{
+				return type_cache<serialization_plan>::of(type);
+			}
+
+			const type_view& type() const { return m_type; }
+			// False when the type has a member which can not be serialized, like a pointer or an associative container.
+			bool is_valid() const { return m_is_valid; }
+			iterator_range<const operation*> operations() const { return { m_operations.data(), m_operations.data() + m_operations.size() }; }
+
+			// True when objects of the type are serialized as their bytes. A type described with properties must have a plan
+			// which is one copy of the whole object, as its properties may be pointers although it is trivially copyable.
+			static bool is_raw(const type_view& type)
+			{
+				if (!type.is_trivially_copyable() || type.is_pointer() || type.size() == 0)
+					return false;
+				if (auto container = type.container())
+					return is_raw(container->element_type());
+				if (type.properties().size() == 0)
+					return true;
+
+				auto& plan = of(type);
+				auto operations = plan.operations();
+				if (!plan.is_valid() || operations.size() != 1)
+					return false;
+				auto& op = *operations.begin();
+				return op.code == opcode::copy && !op.is_read_only && op.offset == 0 && op.size == type.size();
+			}
+
+		private:
+			const type_view&		m_type;
+			std::vector<operation>	m_operations;
+			bool					m_is_valid = false;
+
+			bool compile()
+			{
+				if (auto container = m_type.container())
+				{
+					m_operations.push_back({ opcode::container, false, 0, 0, 1, &m_type });
+					return !container->is_associative();
+				}
+				if (m_type.properties().size() == 0)
+				{
+					m_operations.push_back({ opcode::copy, false, 0, m_type.size() });
+					return is_raw(m_type);
+				}
+
+				property_owner_walk owners(m_type);
+				const type_view* base_type = &m_type;
+				for (auto& property : m_type.properties())
+				{
+					auto& owner = owners.next(property);
+					auto& owner_base_type = owner.is_fixed ? m_type : *owner.type;
+					if (base_type != &owner_base_type)
+					{
+						m_operations.push_back({ opcode::rebase, false, 0, 0, 0, &owner_base_type });
+						base_type = &owner_base_type;
+					}
+
+					auto owner_offset = owner.is_fixed ? owner.offset : 0;
+					auto layout = property.layout();
+					auto& value_type = property.value_type();
+					auto offset = owner_offset + layout.offset;
+					if (value_type.is_pointer() || (value_type.container() && value_type.container()->is_associative()))
+						return false;
+					if (layout.is_addressable() && layout.is_trivially_copyable && is_raw(value_type))
+						add_copy(offset, layout.size(), property.is_read_only());
+					else if (layout.is_addressable() && !property.is_read_only())
+					{
+						if (value_type.container() && layout.rank() == 0)
+							m_operations.push_back({ opcode::container, false, offset, 0, 1, &value_type });
+						// An object held by value can not hold this type, so its plan is compiled already or now.
+						else if (!of(value_type).is_valid())
+							return false;
+						else
+							m_operations.push_back({ opcode::object, false, offset, layout.element_size, layout.count(), &value_type });
+					}
+					else if (layout.rank() == 0)
+						m_operations.push_back({ opcode::accessor, property.is_read_only(), owner_offset, 0, 1, owner.type, &property });
+					else
+						return false;
+				}
+				return true;
+			}
+
+			void add_copy(ptrdiff_t offset, size_t size, bool is_read_only)
+			{
+				if (!m_operations.empty())
+				{
+					auto& last = m_operations.back();
+					if (last.code == opcode::copy && last.is_read_only == is_read_only && last.offset + (ptrdiff_t)last.size == offset)
+					{
+						last.size += size;
+						return;
+					}
+				}
+				m_operations.push_back({ opcode::copy, is_read_only, offset, size });
+			}
+		};
+
+		// Serializes objects by the serialization_plan of their types.
+		// Trivially copyable members which are adjacent in memory are copied by a single memcpy.
+		// Sizes of containers are written as uint64_t, all values in the native byte order.
+		class binary_writer : noncopyable
+		{
+		public:
+			binary_writer(std::pmr::memory_resource* resource = get_memory_resource())
+				: m_buffer(resource)
+			{}
+
+			// Returns false when the object has a member which can not be serialized,
+			// like a pointer or an associative container. The buffer is left partially written then.
+			bool write(const value_ref& object)
+			{
+				return object.has_value() && write(object.address(), object.type());
+			}
+			bool write(const void* object, const type_view& type)
+			{
+				return write(object, serialization_plan::of(type));
+			}
+
+			const char* data() const { return m_buffer.data(); }
+			size_t size() const { return m_buffer.size(); }
+			void clear() { m_buffer.clear(); }
+
+		private:
+			using opcode = serialization_plan::opcode;
+
+			std::pmr::vector<char>	m_buffer;
+
+			void append(const void* data, size_t size)
+			{
+				auto position = m_buffer.size();
+				if (position + size > m_buffer.capacity())
+					m_buffer.reserve(std::max(m_buffer.capacity() * 2, position + size));
+				m_buffer.resize(position + size);
+				if (size != 0)
+					std::memcpy(m_buffer.data() + position, data, size);
+			}
+
+			bool write(const void* object, const serialization_plan& plan)
+			{
+				if (!plan.is_valid())
+					return false;
+
+				auto base = static_cast<const char*>(object);
+				for (auto& op : plan.operations())
+				{
+					switch (op.code)
+					{
+					case opcode::copy:
+						append(base + op.offset, op.size);
+						break;
+					case opcode::object:
+						for (size_t i = 0; i < op.count; ++i)
+						{
+							if (!write(base + op.offset + i * op.size, *op.type))
+								return false;
+						}
+						break;
+					case opcode::container:
+						if (!write_container(base + op.offset, *op.type->container()))
+							return false;
+						break;
+					case opcode::accessor:
+						if (!write_accessor(base + op.offset, *op.type, *op.property))
+							return false;
+						break;
+					case opcode::rebase:
+						base = static_cast<const char*>(upcast(const_cast<void*>(object), plan.type(), *op.type));
+						if (base == nullptr)
+							return false;
+						break;
+					}
+				}
+				return true;
+			}
+
+			bool write_accessor(const void* owner, const type_view& owner_type, const property_view& property)
+			{
+				auto pointer = value_ref(owner_type, owner).pointer();
+				if (property.is_referable())
+					return write(property.view(pointer));
+				auto copy = property.get(pointer);
+				return write(value_ref(copy));
+			}
+
+			bool write_container(const void* object, const container_view& container)
+			{
+				uint64_t size = container.size(object);
+				append(&size, sizeof(size));
+				auto& element_type = container.element_type();
+				if (container.is_contiguous() && serialization_plan::is_raw(element_type))
+				{
+					append(container.data(object), size * element_type.size());
+					return true;
+				}
+				auto& plan = serialization_plan::of(element_type);
+				for (auto cursor = container.begin(object); !cursor.is_end(); cursor.next())
+				{
+					if (!write(cursor.get().address(), plan))
+						return false;
+				}
+				return true;
+			}
+		};
+
+		// Reads objects written by binary_writer into existing objects of the same types.
+		class binary_reader
+		{
+		public:
+			binary_reader(const void* data, size_t size)
+				: m_position(static_cast<const char*>(data))
+				, m_end(static_cast<const char*>(data) + size)
+			{}
+
+			// Returns false when the data is short or the object can not be deserialized.
+			bool read(const value_ref& object)
+			{
+				return object.has_value() && !object.is_const() && read(const_cast<void*>(object.address()), object.type());
+			}
+			bool read(void* object, const type_view& type)
+			{
+				return read(object, serialization_plan::of(type));
+			}
+
+			// Bytes which are not read yet.
+			size_t remaining() const { return m_end - m_position; }
+
+		private:
+			using opcode = serialization_plan::opcode;
+
+			const char*	m_position;
+			const char*	m_end;
+
+			bool take(void* data, size_t size)
+			{
+				if (size > remaining())
+					return false;
+				if (size != 0)
+					std::memcpy(data, m_position, size);
+				m_position += size;
+				return true;
+			}
+			bool skip(size_t size)
+			{
+				if (size > remaining())
+					return false;
+				m_position += size;
+				return true;
+			}
+
+			bool read(void* object, const serialization_plan& plan)
+			{
+				if (!plan.is_valid())
+					return false;
+
+				auto base = static_cast<char*>(object);
+				for (auto& op : plan.operations())
+				{
+					switch (op.code)
+					{
+					case opcode::copy:
+						if (!(op.is_read_only ? skip(op.size) : take(base + op.offset, op.size)))
+							return false;
+						break;
+					case opcode::object:
+						for (size_t i = 0; i < op.count; ++i)
+						{
+							if (!read(base + op.offset + i * op.size, *op.type))
+								return false;
+						}
+						break;
+					case opcode::container:
+						if (!read_container(base + op.offset, *op.type->container()))
+							return false;
+						break;
+					case opcode::accessor:
+						if (!read_accessor(base + op.offset, *op.type, *op.property))
+							return false;
+						break;
+					case opcode::rebase:
+						base = static_cast<char*>(upcast(object, plan.type(), *op.type));
+						if (base == nullptr)
+							return false;
+						break;
+					}
+				}
+				return true;
+			}
+
+			// A property which has a getter only is read into a copy of its value, which is dropped,
+			// as read only copy operations are skipped.
+			bool read_accessor(void* owner, const type_view& owner_type, const property_view& property)
+			{
+				auto pointer = value_ref(owner_type, owner).pointer();
+				if (property.is_read_only())
+				{
+					auto copy = property.get(pointer);
+					return copy.has_value() && read(const_cast<void*>(value_ref(copy).address()), property.value_type());
+				}
+				return read_property_copy(property, pointer, [&](void* address) { return read(address, property.value_type()); });
+			}
+
+			bool read_container(void* object, const container_view& container)
+			{
+				uint64_t size;
+				if (!take(&size, sizeof(size)) || size > remaining())
+					return false;
+				if (!container.fit(object, static_cast<size_t>(size)))
+					return false;
+
+				auto& element_type = container.element_type();
+				if (container.is_contiguous() && serialization_plan::is_raw(element_type))
+					return take(container.data(object), static_cast<size_t>(size) * element_type.size());
+				auto& plan = serialization_plan::of(element_type);
+				for (auto cursor = container.begin(object); !cursor.is_end(); cursor.next())
+				{
+					if (!read(const_cast<void*>(cursor.get().address()), plan))
+						return false;
+				}
+				return true;
+			}
+		};
+
+		enum class json_kind : uint8_t
+		{
+			unsupported,	// pointers, associative containers and types without properties
+			boolean,
+			integer,		// integral types and enums without enumerators
+			floating,
+			enumeration,	// enums by the names of their enumerators
+			string,			// contiguous containers of char
+			array,			// other containers and array members
+			object,			// types with properties
+		};
+
+		// Calls f with a zero of the fixed width integer type which has the size and signedness.
+		template<typename F>
+		bool visit_integer_type(size_t size, bool is_signed, F&& f)
+		{
+			switch (size)
+			{
+			case 1: return is_signed ? f(int8_t()) : f(uint8_t());
+			case 2: return is_signed ? f(int16_t()) : f(uint16_t());
+			case 4: return is_signed ? f(int32_t()) : f(uint32_t());
+			case 8: return is_signed ? f(int64_t()) : f(uint64_t());
+			default: return false;
+			}
+		}
+		template<typename F>
+		bool visit_floating_type(size_t size, F&& f)
+		{
+			if (size == sizeof(float))
+				return f(float());
+			if (size == sizeof(double))
+				return f(double());
+			if (size == sizeof(long double))
+				return f((long double)0);
+			return false;
+		}
+
+		// Appends text quoted as a JSON string. Other bytes than quotes, backslashes and control characters are copied as they are.
+		template<typename String>
+		void append_json_string(String& out, std::string_view text)
+		{
+			static constexpr char hex[] = "0123456789abcdef";
+			out += '"';
+			size_t run = 0;
+			for (size_t i = 0; i < text.size(); ++i)
+			{
+				auto c = static_cast<unsigned char>(text[i]);
+				if (c >= 0x20 && c != '"' && c != '\\')
+					continue;
+				out.append(text.data() + run, i - run);
+				run = i + 1;
+				switch (c)
+				{
+				case '"': out.append("\\\"", 2); break;
+				case '\\': out.append("\\\\", 2); break;
+				case '\b': out.append("\\b", 2); break;
+				case '\f': out.append("\\f", 2); break;
+				case '\n': out.append("\\n", 2); break;
+				case '\r': out.append("\\r", 2); break;
+				case '\t': out.append("\\t", 2); break;
+				default:
+				{
+					const char escape[] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 15] };
+					out.append(escape, sizeof(escape));
+				}
+				}
+			}
+			out.append(text.data() + run, text.size() - run);
+			out += '"';
+		}
+
+		// How values of a type are written as JSON, built once per type by type_cache.
+		// Objects bind their properties with precomputed keys and an index which finds them by name or display name.
+		class json_binding : noncopyable
+		{
+		public:
+			struct member
+			{
+				const property_view*	property = nullptr;
+				const type_view*		owner_type = nullptr;	// the type which declares the property
+				ptrdiff_t				owner_offset = 0;		// offset of owner_type in the object when is_fixed
+				bool					is_fixed = true;		// false for a virtual base, which is found by upcast
+				property_layout			layout;
+				const json_binding*		binding = nullptr;		// of the value type
+				std::string				key;					// the quoted name followed by ':'
+			};
+
+			explicit json_binding(const type_view& type)
+				: m_type(type)
+				, m_kind(classify(type))
+			{
+				if (m_kind == json_kind::object)
+					bind_members();
+			}
+
+			static const json_binding& of(const type_view& type)
+			{
+				return type_cache<json_binding>::of(type);
+			}
+
+			const type_view& type() const { return m_type; }
+			json_kind kind() const { return m_kind; }
+			iterator_range<const member*> members() const { return { m_members.data(), m_members.data() + m_members.size() }; }
+
+			// Finds the member whose property has the name or the display name.
+			const member* find(std::string_view key) const
+			{
+				if (m_slots.empty())
+					return nullptr;
+				auto mask = m_slots.size() - 1;
+				for (auto i = enumerator_slot(key, mask); m_slots[i] != 0; i = (i + 1) & mask)
+				{
+					auto& entry = m_keys[m_slots[i] - 1];
+					if (entry.first == key)
+						return &m_members[entry.second];
+				}
+				return nullptr;
+			}
+
+			// Binding of the elements of a container. It is looked up on first use, as the elements may contain this type.
+			const json_binding& element() const
+			{
+				auto element = m_element.load(std::memory_order_acquire);
+				if (element == nullptr)
+				{
+					element = &of(m_type.container()->element_type());
+					m_element.store(element, std::memory_order_release);
+				}
+				return *element;
+			}
+
+			// Address of the subobject which declares the property of the member.
+			void* owner(void* object, const member& m) const
+			{
+				if (m.is_fixed)
+					return static_cast<char*>(object) + m.owner_offset;
+				return upcast(object, m_type, *m.owner_type);
+			}
+
+		private:
+			const type_view&	m_type;
+			json_kind			m_kind;
+			std::vector<member>	m_members;
+			std::vector<std::pair<std::string_view, uint32_t>>	m_keys;
+			std::vector<uint32_t>	m_slots;		// position in m_keys + 1 by key hash, 0 for empty slots
+			mutable std::atomic<const json_binding*>	m_element = { nullptr };
+
+			static json_kind classify(const type_view& type)
+			{
+				if (type.is_pointer() || type.size() == 0)
+					return json_kind::unsupported;
+				if (type.unconst_type().is<bool>())
+					return json_kind::boolean;
+				if (type.is_enum())
+					return type.enumerators().size() != 0 ? json_kind::enumeration : json_kind::integer;
+				if (type.is_integral())
+					return json_kind::integer;
+				if (type.is_floating_point())
+					return json_kind::floating;
+				// Containers go first, as std::string may be described with properties.
+				if (auto container = type.container())
+				{
+					if (container->is_associative())
+						return json_kind::unsupported;
+					if (container->is_contiguous() && container->element_type().unconst_type().is<char>())
+						return json_kind::string;
+					return json_kind::array;
+				}
+				if (type.properties().size() != 0)
+					return json_kind::object;
+				return json_kind::unsupported;
+			}
+
+			void bind_members()
+			{
+				property_owner_walk owners(m_type);
+				for (auto& property : m_type.properties())
+				{
+					auto& owner = owners.next(property);
+					member m;
+					m.property = &property;
+					m.owner_type = owner.type;
+					m.owner_offset = owner.offset;
+					m.is_fixed = owner.is_fixed;
+					m.layout = property.layout();
+					m.binding = &of(property.value_type());
+					append_json_string(m.key, property.name());
+					m.key += ':';
+					m_members.push_back(std::move(m));
+				}
+
+				size_t slot_count = 1;
+				while (slot_count < m_members.size() * 4)
+					slot_count *= 2;
+				m_slots.resize(slot_count);
+				for (uint32_t i = 0; i < m_members.size(); ++i)
+				{
+					add_key(m_members[i].property->name(), i);
+					add_key(m_members[i].property->display_name(), i);
+				}
+			}
+
+			// The first property keeps a key which several properties have.
+			void add_key(std::string_view key, uint32_t position)
+			{
+				if (find(key))
+					return;
+				auto mask = m_slots.size() - 1;
+				auto i = enumerator_slot(key, mask);
+				while (m_slots[i] != 0)
+					i = (i + 1) & mask;
+				m_keys.emplace_back(key, position);
+				m_slots[i] = (uint32_t)m_keys.size();
+			}
+		};
+
+		// Writes objects as JSON text by their json_binding, without building a document.
+		// Objects are written by the names of their properties, containers and array members as arrays,
+		// and enums by the names of their enumerators, joined by '|' for flags.
+		class json_writer : noncopyable
+		{
+		public:
+			json_writer(std::pmr::memory_resource* resource = get_memory_resource())
+				: m_text(resource)
+			{}
+
+			// Returns false when the object has a value which JSON can not represent, like a pointer, an associative container
+			// or a floating point value which is not finite. The text is left partially written then.
+			bool write(const value_ref& object)
+			{
+				return object.has_value() && write(object.address(), object.type());
+			}
+			bool write(const void* object, const type_view& type)
+			{
+				return write(object, json_binding::of(type));
+			}
+
+			std::string_view text() const { return m_text; }
+			void clear() { m_text.clear(); }
+
+		private:
+			std::pmr::string	m_text;
+			std::string			m_flags;
+
+			bool write(const void* object, const json_binding& binding)
+			{
+				auto& type = binding.type();
+				switch (binding.kind())
+				{
+				case json_kind::boolean:
+					if (*static_cast<const bool*>(object))
+						m_text.append("true", 4);
+					else
+						m_text.append("false", 5);
+					return true;
+				case json_kind::integer:
+					return visit_integer_type(type.size(), type.is_signed(), [&](auto zero)
+						{
+							decltype(zero) value;
+							std::memcpy(&value, object, sizeof(value));
+							return write_number(value);
+						});
+				case json_kind::floating:
+					return visit_floating_type(type.size(), [&](auto zero)
+						{
+							decltype(zero) value;
+							std::memcpy(&value, object, sizeof(value));
+							return std::isfinite(value) && write_number(value);
+						});
+				case json_kind::enumeration:
+					return write_enumeration(object, type);
+				case json_kind::string:
+				{
+					auto container = type.container();
+					append_json_string(m_text, { static_cast<const char*>(container->data(object)), container->size(object) });
+					return true;
+				}
+				case json_kind::array:
+					return write_array(object, binding);
+				case json_kind::object:
+					return write_object(object, binding);
+				default:
+					return false;
+				}
+			}
+
+			template<typename T>
+			bool write_number(T value)
+			{
+				char buffer[64];
+				auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+				if (result.ec != std::errc())
+					return false;
+				m_text.append(buffer, result.ptr - buffer);
+				return true;
+			}
+
+			bool write_enumeration(const void* object, const type_view& type)
+			{
+				int64_t value = 0;
+				visit_integer_type(type.size(), type.is_signed(), [&](auto zero)
+					{
+						decltype(zero) v;
+						std::memcpy(&v, object, sizeof(v));
+						value = static_cast<int64_t>(v);
+						return true;
+					});
+				auto enumerators = type.enumerators();
+				if (auto e = enumerators.get_by_value(value))
+					append_json_string(m_text, e->name());
+				else if (enumerators.format_flags(value, m_flags))
+					append_json_string(m_text, m_flags);
+				else
+					write_number(value);
+				return true;
+			}
+
+			bool write_array(const void* object, const json_binding& binding)
+			{
+				auto& container = *binding.type().container();
+				auto& element = binding.element();
+				m_text += '[';
+				if (auto data = static_cast<const char*>(container.data(object)))
+				{
+					auto size = container.size(object);
+					auto stride = element.type().size();
+					for (size_t i = 0; i < size; ++i)
+					{
+						if (i != 0)
+							m_text += ',';
+						if (!write(data + i * stride, element))
+							return false;
+					}
+				}
+				else
+				{
+					bool is_first = true;
+					for (auto cursor = container.begin(object); !cursor.is_end(); cursor.next())
+					{
+						if (!is_first)
+							m_text += ',';
+						is_first = false;
+						if (!write(cursor.get().address(), element))
+							return false;
+					}
+				}
+				m_text += ']';
+				return true;
+			}
+
+			bool write_object(const void* object, const json_binding& binding)
+			{
+				m_text += '{';
+				bool is_first = true;
+				for (auto& member : binding.members())
+				{
+					if (!is_first)
+						m_text += ',';
+					is_first = false;
+					m_text.append(member.key.data(), member.key.size());
+					if (!write_member(object, binding, member))
+						return false;
+				}
+				m_text += '}';
+				return true;
+			}
+
+			bool write_member(const void* object, const json_binding& binding, const json_binding::member& member)
+			{
+				auto owner = binding.owner(const_cast<void*>(object), member);
+				if (owner == nullptr)
+					return false;
+				auto& property = *member.property;
+				auto& value_binding = *member.binding;
+				if (member.layout.is_addressable())
+					return write_elements(static_cast<const char*>(owner) + member.layout.offset, value_binding, member.layout.extents, member.layout.element_size);
+				if (property.rank() != 0)
+					return false;
+
+				auto pointer = value_ref(*member.owner_type, owner).pointer();
+				if (property.is_referable())
+				{
+					auto view = property.view(pointer);
+					return view.has_value() && write(view.address(), value_binding);
+				}
+				auto copy = property.get(pointer);
+				return copy.has_value() && write(value_ref(copy).address(), value_binding);
+			}
+
+			// Writes an array member as nested arrays, from the outermost extent.
+			bool write_elements(const char* address, const json_binding& element, iterator_range<const size_t*> extents, size_t element_size)
+			{
+				if (extents.size() == 0)
+					return write(address, element);
+				iterator_range<const size_t*> inner = { extents.begin() + 1, extents.end() };
+				auto stride = element_size;
+				for (auto extent : inner)
+					stride *= extent;
+				m_text += '[';
+				for (size_t i = 0; i < *extents.begin(); ++i)
+				{
+					if (i != 0)
+						m_text += ',';
+					if (!write_elements(address + i * stride, element, inner, element_size))
+						return false;
+				}
+				m_text += ']';
+				return true;
+			}
+		};
+
+		enum class simd_level : uint8_t
+		{
+			scalar,
+			sse2,
+			avx2,
+		};
+
+#if defined(RTTI_SIMD_X86) && defined(_MSC_VER)
+		// clang-cl declares _xgetbv for targets with xsave only, which the caller checks by cpuid first.
+#if defined(__clang__)
+		__attribute__((target("xsave")))
+#endif
+		inline unsigned long long read_xcr0() { return _xgetbv(0); }
+#endif
+
+		// The best level which the processor supports, checked once.
+		// MSVC builds, clang-cl included, query cpuid by the intrinsics of <intrin.h>.
+		// __builtin_cpu_supports needs __cpu_model of compiler-rt, which clang-cl does not link by default.
+		inline simd_level supported_simd_level()
+		{
+#if defined(RTTI_SIMD_X86)
+			static const simd_level level = []
+			{
+#if defined(_MSC_VER)
+				int info[4];
+				__cpuid(info, 0);
+				auto max_leaf = info[0];
+				__cpuid(info, 1);
+				bool sse2 = (info[3] & (1 << 26)) != 0;
+				bool avx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (read_xcr0() & 6) == 6;
+				bool avx2 = false;
+				if (avx && max_leaf >= 7)
+				{
+					__cpuidex(info, 7, 0);
+					avx2 = (info[1] & (1 << 5)) != 0;
+				}
+#else
+				__builtin_cpu_init();
+				bool sse2 = __builtin_cpu_supports("sse2");
+				bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+				return avx2 ? simd_level::avx2 : sse2 ? simd_level::sse2 : simd_level::scalar;
+			}();
+			return level;
+#else
+			return simd_level::scalar;
+#endif
+		}
+
+		inline int count_trailing_zeros(uint64_t bits)
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			unsigned long i;
+#if defined(_M_X64) || defined(_M_ARM64)
+			_BitScanForward64(&i, bits);
+#else
+			if (_BitScanForward(&i, (unsigned long)bits))
+				return (int)i;
+			_BitScanForward(&i, (unsigned long)(bits >> 32));
+			i += 32;
+#endif
+			return (int)i;
+#else
+			return __builtin_ctzll(bits);
+#endif
+		}
+
+		inline size_t count_bits(uint64_t bits)
+		{
+			bits = bits - ((bits >> 1) & 0x5555555555555555);
+			bits = (bits & 0x3333333333333333) + ((bits >> 2) & 0x3333333333333333);
+			bits = (bits + (bits >> 4)) & 0x0F0F0F0F0F0F0F0F;
+			return (size_t)((bits * 0x0101010101010101) >> 56);
+		}
+
+		// Characters of a 64 byte block of JSON text as bit masks, bit i for byte i.
+		struct json_block
+		{
+			uint64_t	quote = 0;
+			uint64_t	backslash = 0;
+			uint64_t	op = 0;				// brackets, colons and commas
+			uint64_t	whitespace = 0;
+			uint64_t	control = 0;		// bytes below 0x20, which strings must not have
+		};
+
+		inline json_block classify_json_block_scalar(const char* block)
+		{
+			enum : uint8_t { quote = 1, backslash = 2, op = 4, whitespace = 8, control = 16 };
+			static constexpr auto table = []
+			{
+				std::array<uint8_t, 256> result = {};
+				for (int c = 0; c < 0x20; ++c)
+					result[c] = control;
+				result['"'] = quote;
+				result['\\'] = backslash;
+				for (auto c : { '{', '}', '[', ']', ':', ',' })
+					result[(uint8_t)c] = op;
+				for (auto c : { ' ', '\t', '\n', '\r' })
+					result[(uint8_t)c] |= whitespace;
+				return result;
+			}();
+
+			json_block result;
+			for (int i = 0; i < 64; ++i)
+			{
+				auto c = table[static_cast<unsigned char>(block[i])];
+				auto bit = uint64_t(1) << i;
+				result.quote |= (c & quote) ? bit : 0;
+				result.backslash |= (c & backslash) ? bit : 0;
+				result.op |= (c & op) ? bit : 0;
+				result.whitespace |= (c & whitespace) ? bit : 0;
+				result.control |= (c & control) ? bit : 0;
+			}
+			return result;
+		}
+
+#if defined(RTTI_SIMD_X86)
+		RTTI_TARGET("sse2") inline json_block classify_json_block_sse2(const char* block)
+		{
+			json_block result;
+			for (int i = 0; i < 4; ++i)
+			{
+				auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i * 16));
+				// '[' and ']' differ from '{' and '}' by 0x20 only.
+				auto folded = _mm_or_si128(v, _mm_set1_epi8(0x20));
+				auto op = _mm_or_si128(
+					_mm_or_si128(_mm_cmpeq_epi8(folded, _mm_set1_epi8('{')), _mm_cmpeq_epi8(folded, _mm_set1_epi8('}'))),
+					_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(':')), _mm_cmpeq_epi8(v, _mm_set1_epi8(','))));
+				auto whitespace = _mm_or_si128(
+					_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+					_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+				auto control = _mm_cmpeq_epi8(_mm_max_epu8(v, _mm_set1_epi8(0x1F)), _mm_set1_epi8(0x1F));
+				auto shift = i * 16;
+				result.quote |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('"'))) << shift;
+				result.backslash |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))) << shift;
+				result.op |= (uint64_t)(uint16_t)_mm_movemask_epi8(op) << shift;
+				result.whitespace |= (uint64_t)(uint16_t)_mm_movemask_epi8(whitespace) << shift;
+				result.control |= (uint64_t)(uint16_t)_mm_movemask_epi8(control) << shift;
+			}
+			return result;
+		}
+
+		RTTI_TARGET("avx2") inline json_block classify_json_block_avx2(const char* block)
+		{
+			json_block result;
+			for (int i = 0; i < 2; ++i)
+			{
+				auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i * 32));
+				auto folded = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+				auto op = _mm256_or_si256(
+					_mm256_or_si256(_mm256_cmpeq_epi8(folded, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('}'))),
+					_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(','))));
+				auto whitespace = _mm256_or_si256(
+					_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))),
+					_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'))));
+				auto control = _mm256_cmpeq_epi8(_mm256_max_epu8(v, _mm256_set1_epi8(0x1F)), _mm256_set1_epi8(0x1F));
+				auto shift = i * 32;
+				result.quote |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"'))) << shift;
+				result.backslash |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))) << shift;
+				result.op |= (uint64_t)(uint32_t)_mm256_movemask_epi8(op) << shift;
+				result.whitespace |= (uint64_t)(uint32_t)_mm256_movemask_epi8(whitespace) << shift;
+				result.control |= (uint64_t)(uint32_t)_mm256_movemask_epi8(control) << shift;
+			}
+			return result;
+		}
+#endif
+
+		// Positions of the tokens of JSON text, found in bulk before parsing.
+		// They are the brackets, colons and commas outside strings, both quotes of every string and the first
+		// character of every other value, so a token spans from its position to the next one.
+		// Blocks of 64 bytes are classified by SSE2 or AVX2 where available, and the masks are combined with
+		// the state of the previous block as simdjson does.
+		class json_structural_index
+		{
+		public:
+			json_structural_index()
+			{}
+			explicit json_structural_index(std::string_view text, simd_level level = supported_simd_level())
+			{
+				build(text, level);
+			}
+
+			// Returns false when a string is not terminated or has a control character.
+			// The level is lowered to what the processor supports.
+			// Room for a position per byte is allocated, as simdjson does, so the scan never checks for it.
+			bool build(std::string_view text, simd_level level = supported_simd_level())
+			{
+				m_state = {};
+				m_count = 0;
+				m_escape_blocks.assign(text.size() / 64 / 64 + 1, 0);
+				bool is_too_long = text.size() >= UINT32_MAX - 128;
+				// A padded block may add 64 positions, and eight more are written past the last one.
+				auto capacity = (is_too_long ? 0 : text.size()) + 64 + 8 + 1;
+				if (capacity > m_capacity)
+				{
+					m_positions.reset(new uint32_t[capacity]);
+					m_capacity = capacity;
+				}
+				if (is_too_long)
+				{
+					m_positions[0] = 0;
+					return m_is_valid = false;
+				}
+
+				switch (std::min(level, supported_simd_level()))
+				{
+#if defined(RTTI_SIMD_X86)
+				case simd_level::avx2:
+					scan(text, classify_json_block_avx2);
+					break;
+				case simd_level::sse2:
+					scan(text, classify_json_block_sse2);
+					break;
+#endif
+				default:
+					scan(text, classify_json_block_scalar);
+					break;
+				}
+				// The closing position of the last token.
+				m_positions[m_count] = (uint32_t)text.size();
+				return m_is_valid = m_state.error == 0 && m_state.in_string == 0;
+			}
+
+			bool is_valid() const { return m_is_valid; }
+			size_t size() const { return m_count; }
+			// Followed by the size of the text.
+			const uint32_t* positions() const { return m_positions.get(); }
+			// False when no 64 byte block from begin to end has a backslash in a string.
+			bool may_have_escape(size_t begin, size_t end) const
+			{
+				for (auto block = begin / 64; block <= (end - 1) / 64; ++block)
+				{
+					if (m_escape_blocks[block / 64] & uint64_t(1) << (block % 64))
+						return true;
+				}
+				return false;
+			}
+
+		private:
+			struct scan_state
+			{
+				uint64_t	in_string = 0;		// all ones when the previous block ended in a string
+				uint64_t	is_escaped = 0;		// 1 when the first byte of the block is escaped
+				uint64_t	was_scalar = 0;		// 1 when the previous block ended in a number or a literal
+				uint64_t	error = 0;
+			};
+
+			std::unique_ptr<uint32_t[]>	m_positions;
+			size_t					m_capacity = 0;
+			std::vector<uint64_t>	m_escape_blocks;	// a bit for each block with a backslash in a string
+			size_t					m_count = 0;
+			scan_state				m_state;
+			bool					m_is_valid = false;
+
+			template<typename Classify>
+			void scan(std::string_view text, Classify&& classify)
+			{
+				size_t offset = 0;
+				for (; offset + 64 <= text.size(); offset += 64)
+					add(classify(text.data() + offset), offset);
+				if (offset < text.size())
+				{
+					// The rest is padded with spaces, which are no tokens.
+					char block[64];
+					std::memset(block, ' ', sizeof(block));
+					std::memcpy(block, text.data() + offset, text.size() - offset);
+					add(classify(block), offset);
+				}
+			}
+
+			static uint64_t prefix_xor(uint64_t bits)
+			{
+				bits ^= bits << 1;
+				bits ^= bits << 2;
+				bits ^= bits << 4;
+				bits ^= bits << 8;
+				bits ^= bits << 16;
+				bits ^= bits << 32;
+				return bits;
+			}
+
+			void add(const json_block& block, size_t offset)
+			{
+				// A backslash escapes the next byte, unless it is escaped itself. Backslashes are rare, so they are walked one by one.
+				uint64_t escaped = m_state.is_escaped;
+				m_state.is_escaped = 0;
+				for (auto bits = block.backslash & ~escaped; bits != 0; bits &= bits - 1)
+				{
+					auto i = count_trailing_zeros(bits);
+					if (i == 63)
+						m_state.is_escaped = 1;
+					else
+					{
+						escaped |= uint64_t(2) << i;
+						bits &= ~(uint64_t(2) << i);
+					}
+				}
+
+				auto quote = block.quote & ~escaped;
+				// Set from each opening quote to the byte before its closing quote.
+				auto in_string = prefix_xor(quote) ^ m_state.in_string;
+				m_state.in_string = (uint64_t)((int64_t)in_string >> 63);
+				m_state.error |= block.control & in_string;
+				if (block.backslash & in_string)
+					m_escape_blocks[offset / 64 / 64] |= uint64_t(1) << (offset / 64 % 64);
+
+				auto scalar = ~(block.op | block.whitespace | quote | in_string);
+				auto tokens = (block.op & ~in_string) | quote | (scalar & ~(scalar << 1 | m_state.was_scalar));
+				m_state.was_scalar = scalar >> 63;
+
+				// Positions are written eight at a time, which saves a branch for each of them.
+				// The bit 63 keeps the count defined for the positions past the last one.
+				auto positions = m_positions.get() + m_count;
+				auto count = count_bits(tokens);
+				for (size_t i = 0; i < count; i += 8)
+				{
+					for (size_t k = 0; k < 8; ++k)
+					{
+						positions[i + k] = (uint32_t)(offset + count_trailing_zeros(tokens | uint64_t(1) << 63));
+						tokens &= tokens - 1;
+					}
+				}
+				m_count += count;
+			}
+		};
+
+		// Parses decimal digits eight at a time, as a SWAR sum of a little endian word.
+		inline bool is_eight_digits(uint64_t word)
+		{
+			return ((word & 0xF0F0F0F0F0F0F0F0) | (((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+		}
+		inline uint64_t parse_eight_digits(uint64_t word)
+		{
+			word -= 0x3030303030303030;
+			word = word * 10 + (word >> 8);
+			return (((word & 0x000000FF000000FF) * (100 + (1000000ULL << 32))) + (((word >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))) >> 32;
+		}
+
+		// Accumulates the decimal digits from p into value and returns the end of them.
+		// Only the first 19 digits, which can not overflow, are accumulated, but count has all of them.
+		inline const char* parse_digits(const char* p, const char* end, uint64_t& value, size_t& count)
+		{
+			auto begin = p;
+			// Plain 64-bit integer code, which needs a little endian word only.
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+			while (end - p >= 8 && p - begin + 8 + count <= 19)
+			{
+				uint64_t word;
+				std::memcpy(&word, p, sizeof(word));
+				if (!is_eight_digits(word))
+					break;
+				value = value * 100000000 + parse_eight_digits(word);
+				p += 8;
+			}
+#endif
+			for (; p != end && *p >= '0' && *p <= '9'; ++p)
+			{
+				if (p - begin + count < 19)
+					value = value * 10 + (*p - '0');
+			}
+			count += p - begin;
+			return p;
+		}
+
+		// Checks the JSON number grammar, which is stricter than std::from_chars.
+		// It has no leading '+' or zeros, no "inf" or "nan", and a digit on both sides of '.'.
+		inline bool is_json_number(const char* p, const char* end)
+		{
+			auto digits = [&]
+			{
+				auto first = p;
+				for (; p != end && *p >= '0' && *p <= '9'; ++p);
+				return p != first;
+			};
+			p += p != end && *p == '-';
+			if (p != end && *p == '0')
+				++p;
+			else if (!digits())
+				return false;
+			if (p != end && *p == '.' && (++p, !digits()))
+				return false;
+			if (p != end && (*p == 'e' || *p == 'E'))
+			{
+				++p;
+				p += p != end && (*p == '-' || *p == '+');
+				if (!digits())
+					return false;
+			}
+			return p == end;
+		}
+
+		// Parses a JSON number into an integral or floating point value, and checks that it fits.
+		// Integers up to 19 digits and decimals which convert exactly by a single multiplication or division
+		// take the fast path, the rest std::from_chars once the text is checked by is_json_number.
+		template<typename T>
+		bool parse_json_number(const char* begin, const char* end, T& result)
+		{
+			auto p = begin;
+			bool is_negative = p != end && *p == '-';
+			p += is_negative;
+			uint64_t mantissa = 0;
+			size_t digits = 0;
+			p = parse_digits(p, end, mantissa, digits);
+			// The integer part has a digit and no leading zero, which the fast paths rely on.
+			if (digits == 0 || (digits > 1 && begin[is_negative] == '0'))
+				return false;
+			if constexpr (std::is_integral_v<T>)
+			{
+				if (p == end && digits != 0 && digits <= 19 && (!is_negative || std::is_signed_v<T>))
+				{
+					// The magnitude of the minimum of a signed type is one more than the maximum.
+					auto limit = static_cast<uint64_t>(std::numeric_limits<T>::max()) + (is_negative ? 1 : 0);
+					if (mantissa > limit)
+						return false;
+					result = is_negative ? static_cast<T>(0 - mantissa) : static_cast<T>(mantissa);
+					return true;
+				}
+			}
+			else if constexpr (!std::is_same_v<T, long double> && FLT_EVAL_METHOD == 0)
+			{
+				int64_t exponent = 0;
+				if (p != end && *p == '.')
+				{
+					auto fraction = p + 1;
+					p = parse_digits(fraction, end, mantissa, digits);
+					exponent = -(p - fraction);
+					if (p == fraction)
+						p = begin;
+				}
+				if (p != end && (*p == 'e' || *p == 'E'))
+				{
+					auto q = p + 1;
+					bool is_negative_exponent = q != end && *q == '-';
+					q += q != end && (*q == '-' || *q == '+');
+					int64_t value = 0;
+					auto digits_begin = q;
+					for (; q != end && *q >= '0' && *q <= '9' && q - digits_begin < 8; ++q)
+						value = value * 10 + (*q - '0');
+					exponent += is_negative_exponent ? -value : value;
+					p = q == digits_begin ? begin : q;
+				}
+
+				constexpr uint64_t max_mantissa = uint64_t(1) << std::numeric_limits<T>::digits;
+				constexpr int64_t max_exponent = std::is_same_v<T, float> ? 10 : 22;
+				static constexpr T powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+					1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+				if (p == end && digits != 0 && digits <= 19 && mantissa <= max_mantissa && exponent >= -max_exponent && exponent <= max_exponent)
+				{
+					// Both operands are exact, so the result is rounded once as from_chars rounds it.
+					auto value = static_cast<T>(mantissa);
+					value = exponent < 0 ? value / powers[-exponent] : value * powers[exponent];
+					result = is_negative ? -value : value;
+					return true;
+				}
+			}
+
+			if (!is_json_number(begin, end))
+				return false;
+			auto converted = std::from_chars(begin, end, result);
+			return converted.ec == std::errc() && converted.ptr == end;
+		}
+
+		// Parses JSON text straight into existing objects by their json_binding, without building a document.
+		// The text is indexed by json_structural_index first, and the reader walks the tokens of the index.
+		// Keys are found by the key index of the binding. Unknown keys are skipped, and members
+		// which are missing in the text or read only are left unchanged.
+		class json_reader
+		{
+		public:
+			json_reader(std::string_view text, simd_level level = supported_simd_level())
+				: m_text(text.data())
+				, m_index(text, level)
+			{
+				m_token = m_index.positions();
+				m_last = m_token + m_index.size();
+			}
+
+			// Returns false when the text is not JSON or does not match the type of the object.
+			// The object is left partially read then, and offset() is near the error.
+			bool read(const value_ref& object)
+			{
+				return object.has_value() && !object.is_const() && read(const_cast<void*>(object.address()), object.type());
+			}
+			bool read(void* object, const type_view& type)
+			{
+				m_depth = 0;
+				return m_index.is_valid() && read(object, json_binding::of(type));
+			}
+
+			// Position of the next token in the text.
+			size_t offset() const { return *m_token; }
+			// True when only whitespace is left.
+			bool is_end() const { return m_token == m_last; }
+
+		private:
+			// Limits the nesting of objects and arrays, which recursive types would otherwise take from the text.
+			static constexpr size_t max_depth = 512;
+
+			const char*				m_text;
+			json_structural_index	m_index;
+			const uint32_t*			m_token;		// the next token
+			const uint32_t*			m_last;			// the end of the tokens, which points to the size of the text
+			size_t					m_depth = 0;
+			std::string				m_scratch;
+
+			bool read(void* object, const json_binding& binding)
+			{
+				auto& type = binding.type();
+				switch (binding.kind())
+				{
+				case json_kind::boolean:
+				{
+					std::string_view literal;
+					if (!read_scalar(literal))
+						return false;
+					if (literal == "true")
+						*static_cast<bool*>(object) = true;
+					else if (literal == "false")
+						*static_cast<bool*>(object) = false;
+					else
+						return false;
+					return true;
+				}
+				case json_kind::integer:
+				case json_kind::floating:
+					return read_number(object, type);
+				case json_kind::enumeration:
+					return read_enumeration(object, type);
+				case json_kind::string:
+				{
+					std::string_view text;
+					if (!read_string(text))
+						return false;
+					auto container = type.container();
+					if (!container->fit(object, text.size()))
+						return false;
+					if (!text.empty())
+						std::memcpy(container->data(object), text.data(), text.size());
+					return true;
+				}
+				case json_kind::array:
+					return enter() && read_array(object, binding) && leave();
+				case json_kind::object:
+					return enter() && read_object(object, binding) && leave();
+				default:
+					return false;
+				}
+			}
+
+			bool enter() { return ++m_depth <= max_depth; }
+			bool leave() { --m_depth; return true; }
+
+			char peek() const { return m_token != m_last ? m_text[*m_token] : '\0'; }
+			bool consume(char c)
+			{
+				if (peek() != c)
+					return false;
+				++m_token;
+				return true;
+			}
+
+			// Takes a number or a literal, which spans to the next token without the whitespace before it.
+			bool read_scalar(std::string_view& text)
+			{
+				switch (peek())
+				{
+				case '\0': case '"': case '{': case '}': case '[': case ']': case ':': case ',':
+					return false;
+				}
+				auto begin = m_text + m_token[0];
+				auto end = m_text + m_token[1];
+				while (end[-1] == ' ' || end[-1] == '\n' || end[-1] == '\r' || end[-1] == '\t')
+					--end;
+				++m_token;
+				text = { begin, (size_t)(end - begin) };
+				return true;
+			}
+
+			// Refers the text in place unless it has escapes, which are decoded into m_scratch.
+			// The index has the closing quote as the next token.
+			bool read_string(std::string_view& text)
+			{
+				if (peek() != '"')
+					return false;
+				auto begin = m_token[0] + 1;
+				auto end = m_token[1];
+				m_token += 2;
+				if (!m_index.may_have_escape(begin, end))
+				{
+					text = { m_text + begin, end - begin };
+					return true;
+				}
+				if (!decode(m_text + begin, m_text + end))
+					return false;
+				text = m_scratch;
+				return true;
+			}
+
+			bool decode(const char* p, const char* end)
+			{
+				m_scratch.clear();
+				while (p != end)
+				{
+					auto c = *p++;
+					if (c != '\\')
+					{
+						m_scratch += c;
+						continue;
+					}
+					if (p == end)
+						return false;
+					switch (*p++)
+					{
+					case '"': m_scratch += '"'; break;
+					case '\\': m_scratch += '\\'; break;
+					case '/': m_scratch += '/'; break;
+					case 'b': m_scratch += '\b'; break;
+					case 'f': m_scratch += '\f'; break;
+					case 'n': m_scratch += '\n'; break;
+					case 'r': m_scratch += '\r'; break;
+					case 't': m_scratch += '\t'; break;
+					case 'u':
+						if (!decode_code_point(p, end))
+							return false;
+						break;
+					default:
+						return false;
+					}
+				}
+				return true;
+			}
+
+			static bool read_hex(const char*& p, const char* end, uint32_t& code)
+			{
+				if (end - p < 4)
+					return false;
+				code = 0;
+				for (int i = 0; i < 4; ++i)
+				{
+					auto c = *p++;
+					uint32_t digit;
+					if (c >= '0' && c <= '9')
+						digit = c - '0';
+					else if (c >= 'a' && c <= 'f')
+						digit = c - 'a' + 10;
+					else if (c >= 'A' && c <= 'F')
+						digit = c - 'A' + 10;
+					else
+						return false;
+					code = code << 4 | digit;
+				}
+				return true;
+			}
+
+			// Decodes the code point after "\u", with a following low surrogate, as UTF-8.
+			bool decode_code_point(const char*& p, const char* end)
+			{
+				uint32_t code;
+				if (!read_hex(p, end, code))
+					return false;
+				if (code >= 0xD800 && code < 0xDC00)
+				{
+					uint32_t low;
+					if (end - p < 2 || p[0] != '\\' || p[1] != 'u')
+						return false;
+					p += 2;
+					if (!read_hex(p, end, low) || low < 0xDC00 || low >= 0xE000)
+						return false;
+					code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+				}
+				else if (code >= 0xDC00 && code < 0xE000)
+					return false;
+
+				if (code < 0x80)
+					m_scratch += static_cast<char>(code);
+				else if (code < 0x800)
+				{
+					m_scratch += static_cast<char>(0xC0 | code >> 6);
+					m_scratch += static_cast<char>(0x80 | (code & 0x3F));
+				}
+				else if (code < 0x10000)
+				{
+					m_scratch += static_cast<char>(0xE0 | code >> 12);
+					m_scratch += static_cast<char>(0x80 | (code >> 6 & 0x3F));
+					m_scratch += static_cast<char>(0x80 | (code & 0x3F));
+				}
+				else
+				{
+					m_scratch += static_cast<char>(0xF0 | code >> 18);
+					m_scratch += static_cast<char>(0x80 | (code >> 12 & 0x3F));
+					m_scratch += static_cast<char>(0x80 | (code >> 6 & 0x3F));
+					m_scratch += static_cast<char>(0x80 | (code & 0x3F));
+				}
+				return true;
+			}
+
+			bool read_number(void* object, const type_view& type)
+			{
+				std::string_view text;
+				if (!read_scalar(text))
+					return false;
+				auto parse = [&](auto zero)
+				{
+					decltype(zero) value;
+					if (!parse_json_number(text.data(), text.data() + text.size(), value))
+						return false;
+					std::memcpy(object, &value, sizeof(value));
+					return true;
+				};
+				if (type.is_floating_point())
+					return visit_floating_type(type.size(), parse);
+				return visit_integer_type(type.size(), type.is_signed(), parse);
+			}
+
+			// Enums are read from a name, names of flags joined by '|', or a number.
+			bool read_enumeration(void* object, const type_view& type)
+			{
+				if (peek() != '"')
+					return read_number(object, type);
+				std::string_view name;
+				if (!read_string(name))
+					return false;
+				auto enumerators = type.enumerators();
+				int64_t value = 0;
+				if (auto e = enumerators.get(name))
+					value = e->value();
+				else if (!enumerators.parse_flags(name, value))
+					return false;
+				return visit_integer_type(type.size(), type.is_signed(), [&](auto zero)
+					{
+						auto v = static_cast<decltype(zero)>(value);
+						std::memcpy(object, &v, sizeof(v));
+						return true;
+					});
+			}
+
+			// Skips a value of any type by its tokens. Strings inside are not decoded.
+			bool skip_value()
+			{
+				switch (peek())
+				{
+				case '"':
+					m_token += 2;
+					return true;
+				case '{':
+				case '[':
+					break;
+				default:
+				{
+					std::string_view text;
+					return read_scalar(text);
+				}
+				}
+
+				size_t depth = 0;
+				while (m_token != m_last)
+				{
+					auto c = m_text[*m_token++];
+					if (c == '{' || c == '[')
+						++depth;
+					else if ((c == '}' || c == ']') && --depth == 0)
+						return true;
+				}
+				return false;
+			}
+
+			bool read_object(void* object, const json_binding& binding)
+			{
+				if (!consume('{'))
+					return false;
+				if (consume('}'))
+					return true;
+				do
+				{
+					std::string_view key;
+					if (!read_string(key) || !consume(':'))
+						return false;
+					auto member = binding.find(key);
+					if (member == nullptr || member->property->is_read_only())
+					{
+						if (!skip_value())
+							return false;
+					}
+					else if (!read_member(object, binding, *member))
+						return false;
+				} while (consume(','));
+				return consume('}');
+			}
+
+			bool read_member(void* object, const json_binding& binding, const json_binding::member& member)
+			{
+				auto owner = binding.owner(object, member);
+				if (owner == nullptr)
+					return false;
+				auto& property = *member.property;
+				auto& value_binding = *member.binding;
+				if (member.layout.is_addressable())
+					return read_elements(static_cast<char*>(owner) + member.layout.offset, value_binding, member.layout.extents, member.layout.element_size);
+				if (property.rank() != 0)
+					return false;
+
+				auto pointer = value_ref(*member.owner_type, owner).pointer();
+				if (property.is_referable())
+				{
+					auto view = property.view(pointer);
+					if (view.has_value() && !view.is_const())
+						return read(const_cast<void*>(view.address()), value_binding);
+				}
+				return read_property_copy(property, pointer, [&](void* address) { return read(address, value_binding); });
+			}
+
+			// Reads nested arrays into an array member, which must have the same extents.
+			bool read_elements(char* address, const json_binding& element, iterator_range<const size_t*> extents, size_t element_size)
+			{
+				if (extents.size() == 0)
+					return read(address, element);
+				iterator_range<const size_t*> inner = { extents.begin() + 1, extents.end() };
+				auto stride = element_size;
+				for (auto extent : inner)
+					stride *= extent;
+				if (!consume('['))
+					return false;
+				for (size_t i = 0; i < *extents.begin(); ++i)
+				{
+					if ((i != 0 && !consume(',')) || !read_elements(address + i * stride, element, inner, element_size))
+						return false;
+				}
+				return consume(']');
+			}
+
+			// Containers are sized by counting the elements on the index first.
+			bool read_array(void* object, const json_binding& binding)
+			{
+				auto& container = *binding.type().container();
+				auto& element = binding.element();
+				if (element.type().is_const() || !consume('['))
+					return false;
+				auto begin = m_token;
+				size_t size = 0;
+				if (!consume(']'))
+				{
+					do
+					{
+						if (!skip_value())
+							return false;
+						++size;
+					} while (consume(','));
+					if (!consume(']'))
+						return false;
+				}
+				m_token = begin;
+				if (!container.fit(object, size))
+					return false;
+
+				if (auto data = static_cast<char*>(container.data(object)))
+				{
+					auto stride = element.type().size();
+					for (size_t i = 0; i < size; ++i)
+					{
+						if ((i != 0 && !consume(',')) || !read(data + i * stride, element))
+							return false;
+					}
+				}
+				else
+				{
+					size_t i = 0;
+					for (auto cursor = container.begin(object); !cursor.is_end(); cursor.next())
+					{
+						if ((i++ != 0 && !consume(',')) || !read(const_cast<void*>(cursor.get().address()), element))
+							return false;
+					}
+				}
+				return consume(']');
+			}
+		};
+
+		enum class archive_kind : uint8_t
+		{
+			unsupported,	// pointers, associative containers and types which can not be stored by their bytes
+			raw,			// trivially copyable types without properties, stored as their bytes
+			object,			// types with properties, stored as a record of their fields
+			span,			// other containers, stored as an archive_span to their elements
+		};
+
+		// Relative pointer to size elements, which start offset bytes from the span itself.
+		struct archive_span
+		{
+			int64_t		offset;
+			uint64_t	size;
+		};
+
+		// Starts an archive. All values are in the native byte order, so the version does not match on others.
+		struct archive_header
+		{
+			static constexpr char		magic_text[8] = { 'r', 't', 't', 'i', 'a', 'r', 'c', '\0' };
+			static constexpr uint32_t	current_version = 1;
+
+			char		magic[8];
+			uint32_t	version;
+			uint32_t	alignment;		// of the records, which the data of the archive must keep
+			type_id_t	type;			// of the root
+			uint64_t	signature;		// of the layout of the root
+			uint64_t	root;			// offset of the root record
+			uint64_t	size;			// of the archive
+		};
+
+		// How values of a type are stored in an archive, built once per type by type_cache.
+		// Fields of a record are at fixed offsets, and containers are spans to elements elsewhere in the archive,
+		// so an archive is read in place without parsing it.
+		class archive_layout : noncopyable
+		{
+		public:
+			struct field
+			{
+				const property_view*	property = nullptr;
+				const type_view*		owner_type = nullptr;	// the type which declares the property
+				ptrdiff_t				owner_offset = 0;		// offset of owner_type in the object when is_fixed
+				bool					is_fixed = true;		// false for a virtual base, which is found by upcast
+				property_layout			layout;					// in the object
+				const archive_layout*	value_layout = nullptr;	// of the value type
+				size_t					offset = 0;				// in the record
+				size_t					count = 1;				// elements of an array member
+			};
+
+			explicit archive_layout(const type_view& type)
+				: m_type(type)
+				, m_kind(classify(type))
+			{
+				if (m_kind == archive_kind::object && !layout_fields())
+					m_kind = archive_kind::unsupported;
+				if (m_kind == archive_kind::raw)
+				{
+					m_size = type.size();
+					m_alignment = type.alignment();
+				}
+				else if (m_kind == archive_kind::span)
+				{
+					m_size = sizeof(archive_span);
+					m_alignment = alignof(archive_span);
+				}
+			}
+
+			static const archive_layout& of(const type_view& type)
+			{
+				return type_cache<archive_layout>::of(type);
+			}
+
+			const type_view& type() const { return m_type; }
+			archive_kind kind() const { return m_kind; }
+			bool is_valid() const { return m_kind != archive_kind::unsupported; }
+			// Size and alignment of a record.
+			size_t size() const { return m_size; }
+			size_t alignment() const { return m_alignment; }
+			// Hash of the type, the record and the layouts of its fields and elements, which an archive must match to be read.
+			// It is computed on first use, as the elements are.
+			uint64_t signature() const
+			{
+				auto result = m_signature.load(std::memory_order_acquire);
+				if (result == 0)
+				{
+					std::vector<const archive_layout*> path;
+					result = make_signature(path) | 1;
+					m_signature.store(result, std::memory_order_release);
+				}
+				return result;
+			}
+			iterator_range<const field*> fields() const { return { m_fields.data(), m_fields.data() + m_fields.size() }; }
+
+			// Finds the field of the property with the name or the display name.
+			const field* find(std::string_view name) const
+			{
+				for (auto& f : m_fields)
+				{
+					if (f.property->name() == name)
+						return &f;
+				}
+				for (auto& f : m_fields)
+				{
+					if (f.property->display_name() == name)
+						return &f;
+				}
+				return nullptr;
+			}
+			// Finds the field of a property of the type, by its position in type().properties().
+			const field* find(const property_view& property) const
+			{
+				// Only a property in the array of type() is located by its address, others are found by name.
+				auto properties = m_type.properties();
+				std::less<const property_view*> less;
+				if (!less(&property, properties.begin()) && less(&property, properties.end()))
+				{
+					auto position = (size_t)(&property - properties.begin());
+					if (position < m_fields.size() && m_fields[position].property == &property)
+						return &m_fields[position];
+				}
+				for (auto& f : m_fields)
+				{
+					if (f.property->name() == property.name() && f.property->object_type() == property.object_type())
+						return &f;
+				}
+				return nullptr;
+			}
+
+			// Layout of the elements of a span, looked up on first use as json_binding::element() is.
+			const archive_layout& element() const
+			{
+				auto element = m_element.load(std::memory_order_acquire);
+				if (element == nullptr)
+				{
+					element = &of(m_type.container()->element_type());
+					m_element.store(element, std::memory_order_release);
+				}
+				return *element;
+			}
+
+			// Address of the subobject which declares the property of the field.
+			void* owner(void* object, const field& f) const
+			{
+				if (f.is_fixed)
+					return static_cast<char*>(object) + f.owner_offset;
+				return upcast(object, m_type, *f.owner_type);
+			}
+
+		private:
+			const type_view&	m_type;
+			archive_kind		m_kind;
+			size_t				m_size = 0;
+			size_t				m_alignment = 1;
+			mutable std::atomic<uint64_t>	m_signature = { 0 };
+			std::vector<field>	m_fields;
+			mutable std::atomic<const archive_layout*>	m_element = { nullptr };
+
+			static archive_kind classify(const type_view& type)
+			{
+				if (type.is_pointer() || type.size() == 0)
+					return archive_kind::unsupported;
+				if (auto container = type.container())
+					return container->is_associative() ? archive_kind::unsupported : archive_kind::span;
+				if (type.properties().size() != 0)
+					return archive_kind::object;
+				if (serialization_plan::is_raw(type))
+					return archive_kind::raw;
+				return archive_kind::unsupported;
+			}
+
+			bool layout_fields()
+			{
+				property_owner_walk owners(m_type);
+				size_t size = 0;
+				for (auto& property : m_type.properties())
+				{
+					auto& owner = owners.next(property);
+					field f;
+					f.property = &property;
+					f.owner_type = owner.type;
+					f.owner_offset = owner.offset;
+					f.is_fixed = owner.is_fixed;
+					f.layout = property.layout();
+					f.value_layout = &of(property.value_type());
+					if (!f.value_layout->is_valid() || (property.rank() != 0 && !f.layout.is_addressable()))
+						return false;
+					f.count = property.rank() != 0 ? f.layout.count() : 1;
+
+					auto alignment = f.value_layout->alignment();
+					f.offset = (size + alignment - 1) & ~(alignment - 1);
+					size = f.offset + f.value_layout->size() * f.count;
+					m_alignment = std::max(m_alignment, alignment);
+					m_fields.push_back(f);
+				}
+				m_size = std::max<size_t>((size + m_alignment - 1) & ~(m_alignment - 1), 1);
+				return true;
+			}
+
+			// path holds the layouts being hashed. A type which holds itself through spans is hashed by its depth on the path there.
+			uint64_t make_signature(std::vector<const archive_layout*>& path) const
+			{
+				uint64_t result = m_type.id();
+				auto mix = [&](uint64_t value) { result = (result ^ value) * 0x100000001B3ULL; };
+				auto cycle = std::find(path.begin(), path.end(), this);
+				if (cycle != path.end())
+				{
+					mix(static_cast<uint64_t>(cycle - path.begin()));
+					return result;
+				}
+
+				path.push_back(this);
+				mix(static_cast<uint64_t>(m_kind));
+				mix(m_size);
+				if (m_kind == archive_kind::span)
+					mix(element().make_signature(path));
+				for (auto& f : m_fields)
+				{
+					mix(hash(f.property->name()));
+					mix(f.offset);
+					mix(f.count);
+					mix(f.value_layout->make_signature(path));
+				}
+				path.pop_back();
+				return result;
+			}
+		};
+
+		// Writes an object and everything it holds into one archive, laid out by the archive_layout of their types.
+		// Records are aligned in the archive as their types are in memory, and strings are stored once in the archive
+		// followed by '\0', however many fields hold them.
+		class archive_writer : noncopyable
+		{
+		public:
+			archive_writer(std::pmr::memory_resource* resource = get_memory_resource())
+				: m_buffer(resource)
+			{}
+
+			// Replaces the archive with the object. Returns false and leaves the archive empty
+			// when the object holds a value which can not be archived, like a pointer or an associative container.
+			bool write(const value_ref& object)
+			{
+				return object.has_value() && write(object.address(), object.type());
+			}
+			bool write(const void* object, const type_view& type)
+			{
+				clear();
+				auto& layout = archive_layout::of(type);
+				if (!layout.is_valid())
+					return false;
+				auto header_position = allocate(sizeof(archive_header), alignof(archive_header));
+				auto root = allocate(layout.size(), layout.alignment());
+				auto result = write(object, layout, root);
+				m_strings.clear();
+				if (!result)
+				{
+					clear();
+					return false;
+				}
+
+				archive_header header = {};
+				std::memcpy(header.magic, archive_header::magic_text, sizeof(header.magic));
+				header.version = archive_header::current_version;
+				header.alignment = static_cast<uint32_t>(m_alignment);
+				header.type = type.id();
+				header.signature = layout.signature();
+				header.root = root;
+				header.size = m_size;
+				std::memcpy(at(header_position), &header, sizeof(header));
+				return true;
+			}
+
+			// The archive, which is aligned for all its records.
+			const char* data() const { return reinterpret_cast<const char*>(m_buffer.data()); }
+			size_t size() const { return m_size; }
+			void clear()
+			{
+				m_buffer.clear();
+				m_size = 0;
+				m_alignment = alignof(archive_header);
+			}
+
+			// Writes the archive to a file, to be mapped by mapped_file.
+			bool save(const char* path) const
+			{
+				auto file = std::fopen(path, "wb");
+				if (file == nullptr)
+					return false;
+				auto result = std::fwrite(data(), 1, m_size, file) == m_size;
+				return std::fclose(file) == 0 && result;
+			}
+
+		private:
+			std::pmr::vector<std::max_align_t>	m_buffer;
+			size_t	m_size = 0;
+			size_t	m_alignment = alignof(archive_header);
+			// Position and size of the strings written, by the hash of their text.
+			std::unordered_multimap<size_t, std::pair<size_t, size_t>>	m_strings;
+
+			char* at(size_t position) { return reinterpret_cast<char*>(m_buffer.data()) + position; }
+
+			// Reserves zeroed bytes at the end, and returns their position. Positions stay valid as the buffer grows.
+			size_t allocate(size_t size, size_t alignment)
 			{
-				return meta_description<C, Bases, Constructors, Properties, Methods, Attributes>(display_name, m_constructors, m_properties, m_methods, m_attributes);
+				auto position = (m_size + alignment - 1) & ~(alignment - 1);
+				auto units = (position + size + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+				if (units > m_buffer.capacity())
+					m_buffer.reserve(std::max(m_buffer.capacity() * 2, units));
+				if (units > m_buffer.size())
+					m_buffer.resize(units);
+				m_size = position + size;
+				m_alignment = std::max(m_alignment, alignment);
+				return position;
 			}
 
-			template<typename ...Args>
-			constexpr auto constructors(Args&&... args) const
+			bool write(const void* object, const archive_layout& layout, size_t position)
 			{
-				auto all = type_constructor_array<Args...>{ std::forward<Args>(args)... };
-				return meta_description<C, Bases, typename decltype(all)::instance_value_type, Properties, Methods, Attributes>(m_display_name, all, m_properties, m_methods, m_attributes);
+				switch (layout.kind())
+				{
+				case archive_kind::raw:
+					std::memcpy(at(position), object, layout.size());
+					return true;
+				case archive_kind::object:
+					return write_fields(object, layout, position);
+				case archive_kind::span:
+					return write_span(object, layout, position);
+				default:
+					return false;
+				}
 			}
 
-			template<typename... Args>
-			constexpr auto properties(Args&&... args) const
+			bool write_fields(const void* object, const archive_layout& layout, size_t position)
 			{
-				auto all = concat_array(m_properties, property_array{ std::forward<Args>(args)... });
-				return meta_description<C, Bases, Constructors, typename decltype(all)::instance_value_type, Methods, Attributes>(m_display_name, m_constructors, all, m_methods, m_attributes);
+				for (auto& f : layout.fields())
+				{
+					auto owner = layout.owner(const_cast<void*>(object), f);
+					if (owner == nullptr)
+						return false;
+					auto& value_layout = *f.value_layout;
+					auto target = position + f.offset;
+					if (f.layout.is_addressable())
+					{
+						auto address = static_cast<const char*>(owner) + f.layout.offset;
+						for (size_t i = 0; i < f.count; ++i)
+						{
+							if (!write(address + i * f.layout.element_size, value_layout, target + i * value_layout.size()))
+								return false;
+						}
+						continue;
+					}
+
+					auto pointer = value_ref(*f.owner_type, owner).pointer();
+					if (f.property->is_referable())
+					{
+						auto view = f.property->view(pointer);
+						if (view.has_value())
+						{
+							if (!write(view.address(), value_layout, target))
+								return false;
+							continue;
+						}
+					}
+					auto copy = f.property->get(pointer);
+					if (!copy.has_value() || !write(value_ref(copy).address(), value_layout, target))
+						return false;
+				}
+				return true;
 			}
 
-			template<typename... Args>
-			constexpr auto methods(Args&&... args) const
+			bool write_span(const void* object, const archive_layout& layout, size_t position)
 			{
-				auto all = concat_array(m_methods, method_array{ std::forward<Args>(args)... });
-				return meta_description<C, Bases, Constructors, Properties, typename decltype(all)::instance_value_type, Attributes>(m_display_name, m_constructors, m_properties, all, m_attributes);
+				auto& container = *layout.type().container();
+				auto& element = layout.element();
+				size_t size = container.size(object);
+				size_t elements = 0;
+				if (size != 0 && element.kind() == archive_kind::raw && container.is_contiguous())
+				{
+					auto data = static_cast<const char*>(container.data(object));
+					if (element.type().unconst_type().is<char>())
+						elements = write_string({ data, size });
+					else
+					{
+						elements = allocate(size * element.size(), element.alignment());
+						std::memcpy(at(elements), data, size * element.size());
+					}
+				}
+				else if (size != 0)
+				{
+					if (!element.is_valid())
+						return false;
+					elements = allocate(size * element.size(), element.alignment());
+					size_t i = 0;
+					for (auto cursor = container.begin(object); !cursor.is_end(); cursor.next())
+					{
+						if (!write(cursor.get().address(), element, elements + i++ * element.size()))
+							return false;
+					}
+				}
+				else
+					elements = position;
+
+				archive_span span = { static_cast<int64_t>(elements) - static_cast<int64_t>(position), size };
+				std::memcpy(at(position), &span, sizeof(span));
+				return true;
 			}
 
-			template<typename... Args>
-			constexpr auto attributes(Args&&... args) const
+			size_t write_string(std::string_view text)
 			{
-				auto all = concat_array(m_attributes, attribute_array{ std::forward<Args>(args)... });
-				return meta_description<C, Bases, Constructors, Properties, Methods, typename decltype(all)::instance_value_type>(m_display_name, m_constructors, m_properties, m_methods, all);
+				auto hash = std::hash<std::string_view>()(text);
+				for (auto [itr, end] = m_strings.equal_range(hash); itr != end; ++itr)
+				{
+					if (itr->second.second == text.size() && std::memcmp(at(itr->second.first), text.data(), text.size()) == 0)
+						return itr->second.first;
+				}
+				auto position = allocate(text.size() + 1, 1);
+				std::memcpy(at(position), text.data(), text.size());
+				m_strings.emplace(hash, std::make_pair(position, text.size()));
+				return position;
 			}
+		};
 
-			constexpr std::string_view display_name() const { return m_display_name; }
-			constexpr const base_set& bases() const { return m_bases; }
-			constexpr const constructor_set& constructors() const { return m_constructors; }
-			constexpr const property_set& properties() const { return m_properties; }
-			constexpr const method_set& methods() const { return m_methods; }
-			constexpr const attribute_set& attributes() const { return m_attributes; }
-			value instantiate(arguments args) const { return m_constructors.instantiate(args); }
-		private:
-			std::string_view				m_display_name;
-			base_set						m_bases;
-			constructor_set					m_constructors;
-			property_set					m_properties;
-			method_set						m_methods;
-			attribute_set					m_attributes;
+		// Read only reference to a value in an archive, which is accessed in place.
+		// Getters return empty references instead of failing, and spans are checked against the bounds of the archive
+		// when they are followed, so only the pages which are touched are read.
+		class archive_ref
+		{
+		public:
+			archive_ref()
+			{}
+			archive_ref(const char* address, const archive_layout& layout, const char* begin, const char* end, size_t count = 0)
+				: m_address(address)
+				, m_layout(&layout)
+				, m_begin(begin)
+				, m_end(end)
+				, m_count(count)
+			{}
 
-		protected:
+			// The root of an archive of the type. Returns an empty reference when data is not such an archive,
+			// was written by another layout of the type, or does not keep the alignment of the archive.
+			static archive_ref open(const void* data, size_t size, const type_view& type)
+			{
+				archive_header header;
+				if (size < sizeof(header) || reinterpret_cast<uintptr_t>(data) % alignof(archive_header) != 0)
+					return {};
+				std::memcpy(&header, data, sizeof(header));
+				auto& layout = archive_layout::of(type);
+				if (std::memcmp(header.magic, archive_header::magic_text, sizeof(header.magic)) != 0
+					|| header.version != archive_header::current_version
+					|| header.type != type.id() || header.signature != layout.signature()
+					|| header.size > size || header.root > header.size || layout.size() > header.size - header.root
+					|| header.alignment == 0 || reinterpret_cast<uintptr_t>(data) % header.alignment != 0
+					|| header.root % layout.alignment() != 0)
+					return {};
+				auto begin = static_cast<const char*>(data);
+				return { begin + header.root, layout, begin, begin + header.size };
+			}
 
-			template<typename Type, typename... Types>
-			static constexpr auto gather_properties(Type t, Types... types)
+			bool has_value() const { return m_layout; }
+			explicit operator bool() const { return has_value(); }
+			const type_view& type() const { return m_layout->type(); }
+			archive_kind kind() const { return m_layout->kind(); }
+			const archive_layout& layout() const { return *m_layout; }
+			const void* address() const { return m_address; }
+			// True for a field of an array member, whose elements are stored in place.
+			bool is_array() const { return m_count != 0; }
+
+			// Raw values, like numbers, enums and structs without properties, in place.
+			value_ref view() const
 			{
-				return concat_array(t.properties(), gather_properties(types...));
+				if (!has_value() || is_array() || kind() != archive_kind::raw)
+					return {};
+				return { type(), static_cast<const void*>(m_address) };
 			}
-			static constexpr auto gather_properties()
+			template<typename V>
+			const V* as() const
 			{
-				return property_set{};
+				if (!has_value() || is_array() || kind() != archive_kind::raw || type().unconst_type() != get_type_view<V>())
+					return nullptr;
+				return reinterpret_cast<const V*>(m_address);
 			}
 
-			template<typename Type, typename... Types>
-			static constexpr auto gather_methods(Type t, Types... types)
+			// Fields of objects.
+			archive_ref field(std::string_view name) const
 			{
-				return concat_array(t.methods(), gather_methods(types...));
+				return has_value() && !is_array() ? field(m_layout->find(name)) : archive_ref();
 			}
-			static constexpr auto gather_methods()
+			archive_ref field(const property_view& property) const
 			{
-				return method_set{};
+				return has_value() && !is_array() ? field(m_layout->find(property)) : archive_ref();
 			}
+			archive_ref field(const char* name) const { return field(std::string_view(name)); }
+			archive_ref operator[](std::string_view name) const { return field(name); }
 
-			template<typename Type, typename... Types>
-			static constexpr auto gather_attributes(Type t, Types... types)
+			// Elements of array members and spans.
+			size_t size() const
 			{
-				return concat_array(t.attributes(), gather_attributes(types...));
+				if (is_array())
+					return m_count;
+				const char* data;
+				size_t size;
+				return elements(data, size) ? size : 0;
 			}
-			static constexpr auto gather_attributes()
+			archive_ref at(size_t i) const
 			{
-				return attribute_set{};
+				if (is_array())
+					return i < m_count ? archive_ref(m_address + i * m_layout->size(), *m_layout, m_begin, m_end) : archive_ref();
+				const char* data;
+				size_t size;
+				if (!elements(data, size) || i >= size)
+					return {};
+				auto& element = m_layout->element();
+				return { data + i * element.size(), element, m_begin, m_end };
+			}
+			archive_ref operator[](size_t i) const { return at(i); }
+			// Elements of a span of raw V in place, or nullptr when they are not.
+			template<typename V>
+			const V* data() const
+			{
+				const char* data;
+				size_t size;
+				if (is_array() || !elements(data, size) || m_layout->element().kind() != archive_kind::raw
+					|| m_layout->element().type().unconst_type() != get_type_view<V>())
+					return nullptr;
+				return reinterpret_cast<const V*>(data);
+			}
+			// Spans of char in place, like std::string.
+			std::string_view string() const
+			{
+				if (auto text = data<char>())
+					return { text, size() };
+				return {};
 			}
-		};
-
-		template<typename T>
-		inline const type_view type_view_instance = { type<T>() };
-
-		template<typename T>
-		inline const type_view& get_type_view()
-		{
-			return type_view_instance<T>;
-		}
-
-		inline const type_view& get_type_view_once_pointer(const type_view& type)
-		{
-			return type.once_pointer_type();
-		}
-		inline const type_view& get_type_view_const(const type_view& type)
-		{
-			return type.const_type();
-		}
-
-		template<typename T> 
-		const T* value_cast(const value& v)
-		{
-			static_assert(!std::is_reference_v<T>);
-
-			if (!v.has_value())
-				return nullptr;
-
-			if (v.type() == get_type_view<T>())
-				return reinterpret_cast<T*>(v.buffer_address());
 
-			if constexpr (std::is_pointer_v<T> && std::is_const_v<std::remove_pointer_t<T>>)
+			// Copies the value into an object of type(). Read only properties are left unchanged.
+			// Returns false when the archive is broken, and the object is left partially read then.
+			bool load(void* object) const
 			{
-				using attempt_type = std::remove_const_t<std::remove_pointer_t<T>>*;
-				if (v.type() == get_type_view<attempt_type>())
-					return reinterpret_cast<attempt_type*>(v.buffer_address());
+				if (!has_value())
+					return false;
+				if (is_array())
+				{
+					for (size_t i = 0; i < m_count; ++i)
+					{
+						if (!at(i).load(static_cast<char*>(object) + i * type().size()))
+							return false;
+					}
+					return true;
+				}
+				switch (kind())
+				{
+				case archive_kind::raw:
+					std::memcpy(object, m_address, m_layout->size());
+					return true;
+				case archive_kind::object:
+					return load_fields(object);
+				case archive_kind::span:
+					return load_span(object);
+				default:
+					return false;
+				}
+			}
+			bool load(const value_ref& object) const
+			{
+				return has_value() && object.has_value() && !object.is_const() && object.type().unconst_type() == type().unconst_type()
+					&& load(const_cast<void*>(object.address()));
 			}
-			
-			return nullptr;
-		}
 
-		template<typename To> To* object_cast(void* ptr, const type_view& from_type);
-		template<typename T> T* value_cast_object(const value& v)
-		{
-			static_assert(std::is_class_v<T> || std::is_void_v<T>);
+			// Accessors of the fields of objects, like those of property_view and property_handle on live objects.
+			// get() copies the value out, view() refers a raw value in place, and read() copies into value, a value_type() of the property.
+			template<typename V>
+			V get(const property_view& property) const
+			{
+				V result{};
+				if (property.value_type() == get_type_view<V>())
+					read(property, &result);
+				return result;
+			}
+			value_ref view(const property_view& property) const
+			{
+				return field(property).view();
+			}
+			bool read(const property_view& property, void* value) const
+			{
+				auto f = field(property);
+				return !f.is_array() && f.load(value);
+			}
 
-			if (!v.has_value())
-				return nullptr;
+		private:
+			const char*				m_address = nullptr;
+			const archive_layout*	m_layout = nullptr;
+			const char*				m_begin = nullptr;		// bounds of the archive
+			const char*				m_end = nullptr;
+			size_t					m_count = 0;			// elements of an array member, 0 for other values
 
-			using value_type = std::remove_const_t<T>;
-			constexpr bool is_void = std::is_void_v<value_type>;
+			archive_ref field(const archive_layout::field* f) const
+			{
+				if (f == nullptr)
+					return {};
+				return { m_address + f->offset, *f->value_layout, m_begin, m_end, f->property->rank() != 0 ? f->count : 0 };
+			}
 
-			if (v.type().is_pointer())
+			// Follows the span, which must point to whole elements inside the archive.
+			bool elements(const char*& data, size_t& size) const
 			{
-				if (!v.type().unpointer_type().is_const() || std::is_const_v<T>)
+				if (!has_value() || kind() != archive_kind::span)
+					return false;
+				archive_span span;
+				std::memcpy(&span, m_address, sizeof(span));
+				auto& element = m_layout->element();
+				auto position = (m_address - m_begin) + span.offset;
+				auto capacity = m_end - m_begin;
+				if (span.size == 0)
 				{
-					if constexpr (is_void)
-						return *reinterpret_cast<void**>(v.buffer_address());
-					else
-						return object_cast<value_type>(
-							*reinterpret_cast<void**>(v.buffer_address()), v.type().unpointer_type().unconst_type());
+					data = m_address;
+					size = 0;
+					return true;
 				}
+				if (!element.is_valid() || position < 0 || position > capacity
+					|| span.size > static_cast<uint64_t>(capacity - position) / element.size() || position % element.alignment() != 0)
+					return false;
+				data = m_begin + position;
+				size = static_cast<size_t>(span.size);
+				return true;
 			}
-			else
+
+			bool load_fields(void* object) const
 			{
-				// If value has a instanced T, return the address of storage whitch it has directly.
-				// This case are allowed when T has const qualifer.
-				if constexpr (std::is_const_v<T>)
+				for (auto& f : m_layout->fields())
 				{
-					if constexpr (is_void)
-						return reinterpret_cast<const void*>(v.buffer_address());
-					else
-						return object_cast<value_type>(
-							reinterpret_cast<void*>(v.buffer_address()), v.type().unpointer_type().unconst_type());
+					if (f.property->is_read_only())
+						continue;
+					auto owner = m_layout->owner(object, f);
+					if (owner == nullptr)
+						return false;
+					auto value = field(&f);
+					if (f.layout.is_addressable())
+					{
+						if (!value.load(static_cast<char*>(owner) + f.layout.offset))
+							return false;
+						continue;
+					}
+					auto pointer = value_ref(*f.owner_type, owner).pointer();
+					if (!read_property_copy(*f.property, pointer, [&](void* address) { return value.load(address); }))
+						return false;
 				}
+				return true;
 			}
 
-			return nullptr;
-		}
+			bool load_span(void* object) const
+			{
+				const char* data;
+				size_t size;
+				if (!elements(data, size))
+					return false;
+				auto& container = *type().container();
+				if (!container.fit(object, size))
+					return false;
+				auto& element = m_layout->element();
+				if (element.kind() == archive_kind::raw && container.is_contiguous())
+				{
+					if (size != 0)
+						std::memcpy(container.data(object), data, size * element.size());
+					return true;
+				}
+				size_t i = 0;
+				for (auto cursor = container.begin(object); !cursor.is_end(); cursor.next())
+				{
+					auto target = cursor.get();
+					if (target.is_const() || !archive_ref(data + i++ * element.size(), element, m_begin, m_end).load(const_cast<void*>(target.address())))
+						return false;
+				}
+				return true;
+			}
+		};
 
-		inline bool is_base_of(const type_view& base_type, const type_view& derived_type)
+		// Archive whose root is a T, checked against its header when it is opened.
+		template<typename T>
+		class archive_view : public archive_ref
 		{
-			if (base_type.id() == derived_type.id())
-				return true;
+		public:
+			archive_view()
+			{}
+			// data must outlive the view. The view is empty when data is not an archive of T with the current layout of T.
+			archive_view(const void* data, size_t size)
+				: archive_ref(open(data, size, get_type_view<T>()))
+			{}
 
-			for (auto& derived_base : derived_type.bases())
+			using archive_ref::load;
+			bool load(T& object) const
 			{
-				if (is_base_of(base_type, derived_base))
-					return true;
+				return archive_ref::load(static_cast<void*>(&object));
 			}
+		};
 
-			return false;
-		}
-
-		template<typename Base>
-		inline bool is_base_of(const type_view& derived_type)
+#if defined(RTTI_MAPPED_FILE)
+		// Read only mapping of a whole file, whose pages are read when they are first touched.
+		class mapped_file : noncopyable
 		{
-			return is_base_of(get_type_view<std::decay_t<Base>>(), derived_type);
-		}
+		public:
+			mapped_file()
+			{}
+			explicit mapped_file(const char* path)
+			{
+				open(path);
+			}
+			~mapped_file()
+			{
+				close();
+			}
 
-		template<typename To>
-		inline To* object_cast(void* ptr, const type_view& from_type)
-		{
-			if (is_base_of(get_type_view<To>(), from_type))
-				return reinterpret_cast<To*>(ptr);
-			return nullptr;
-		}
+			// Returns false when the file can not be opened or mapped, or is empty.
+			bool open(const char* path)
+			{
+				close();
+#if defined(_WIN32)
+				auto file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+				if (file == INVALID_HANDLE_VALUE)
+					return false;
+				LARGE_INTEGER size;
+				HANDLE mapping = nullptr;
+				if (GetFileSizeEx(file, &size) && size.QuadPart > 0 && static_cast<uint64_t>(size.QuadPart) <= SIZE_MAX)
+					mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				CloseHandle(file);
+				if (mapping == nullptr)
+					return false;
+				// The view keeps the mapping open.
+				auto data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+				CloseHandle(mapping);
+				if (data == nullptr)
+					return false;
+				m_data = static_cast<const char*>(data);
+				m_size = static_cast<size_t>(size.QuadPart);
+#else
+				auto file = ::open(path, O_RDONLY);
+				if (file < 0)
+					return false;
+				struct stat status;
+				auto data = MAP_FAILED;
+				if (fstat(file, &status) == 0 && status.st_size > 0)
+					data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+				::close(file);
+				if (data == MAP_FAILED)
+					return false;
+				m_data = static_cast<const char*>(data);
+				m_size = static_cast<size_t>(status.st_size);
+#endif
+				return true;
+			}
+			void close()
+			{
+				if (m_data == nullptr)
+					return;
+#if defined(_WIN32)
+				UnmapViewOfFile(m_data);
+#else
+				munmap(const_cast<char*>(m_data), m_size);
+#endif
+				m_data = nullptr;
+				m_size = 0;
+			}
 
-		template<typename To, typename From>
-		inline To* object_cast(From* object)
-		{
-			if constexpr (std::is_convertible_v<From*, To*>)
-				return static_cast<To*>(object);
-			else if (is_base_of<To>(object->rtti_type_view()))
-				return reinterpret_cast<To*>(object);
-			return nullptr;
-		}
+			bool is_open() const { return m_data; }
+			// Page aligned, which keeps the alignment of archives.
+			const char* data() const { return m_data; }
+			size_t size() const { return m_size; }
+
+		private:
+			const char*	m_data = nullptr;
+			size_t		m_size = 0;
+		};
+#endif
 	}
 
 	using attribute = impl::attribute;
@@ -1798,6 +7393,33 @@ namespace rtti
 	using method_iterable = impl::method_iterable;
 	using attribute_iterable = impl::attribute_iterable;
 	using value = impl::value;
+	using value_ref = impl::value_ref;
+	using arena_resource = impl::arena_resource;
+	using memory_resource_scope = impl::memory_resource_scope;
+	using object_pool = impl::object_pool;
+	using binary_writer = impl::binary_writer;
+	using binary_reader = impl::binary_reader;
+	using serialization_plan = impl::serialization_plan;
+	using json_writer = impl::json_writer;
+	using json_reader = impl::json_reader;
+	using json_binding = impl::json_binding;
+	using json_kind = impl::json_kind;
+	using json_structural_index = impl::json_structural_index;
+	using simd_level = impl::simd_level;
+	using archive_writer = impl::archive_writer;
+	using archive_ref = impl::archive_ref;
+	using archive_layout = impl::archive_layout;
+	using archive_kind = impl::archive_kind;
+#if defined(RTTI_MAPPED_FILE)
+	using mapped_file = impl::mapped_file;
+#endif
+	using container_view = impl::container_view;
+	using container_cursor = impl::container_cursor;
+	using enumerator_view = impl::enumerator_view;
+	using enumerator_iterable = impl::enumerator_iterable;
+	template<typename T, typename V> using property_handle = impl::property_handle<T, V>;
+	template<typename Signature> using bound_method = impl::bound_method<Signature>;
+	template<typename T> using archive_view = impl::archive_view<T>;
 
 	template<typename ...Types>
 	class index : public impl::index<Types...>
@@ -1811,7 +7433,8 @@ namespace rtti
 #define rtti_class_decl(Class)				\
 	friend struct ::rtti::impl::meta<Class>;	\
 	static const ::rtti::impl::type_view_chain Rtti;	\
-	virtual const ::rtti::impl::type_view& rtti_type_view() const { return Rtti.view(); }
+	virtual const ::rtti::impl::type_view& rtti_type_view() const { return Rtti.view(); }	\
+	virtual void* rtti_object_address() const { return const_cast<Class*>(this); }
 
 #define rtti_class_impl(Class, ...)				\
 	template<> struct ::rtti::impl::meta<Class> {	\
@@ -1824,6 +7447,12 @@ namespace rtti
 	namespace rtti_types::Class##_def{			\
 		inline const ::rtti::impl::type_view_chain Rtti = { rtti::impl::get_type_view<::Class>() }; }
 
+#define rtti_enum_impl(Enum, ...)				\
+	template<> struct ::rtti::impl::meta<Enum> {	\
+		inline static constexpr auto description = ::rtti::impl::enum_description<Enum>::initialize(get_type_name<Enum>()) __VA_ARGS__; };  \
+	namespace rtti_types::Enum##_def{			\
+		inline const ::rtti::impl::type_view_chain Rtti = { rtti::impl::get_type_view<::Enum>() }; }
+
 
 	template<typename T> inline const T* value_cast(const impl::value& v)
 	{
@@ -1835,10 +7464,32 @@ namespace rtti
 			return *p;
 		return default_value;
 	}
+	template<typename T> inline const T* value_cast(const impl::value_ref& v)
+	{
+		return impl::value_cast<T>(v);
+	}
+	template<typename T> inline const T& value_cast(const impl::value_ref& v, const T& default_value)
+	{
+		if (auto p = impl::value_cast<T>(v))
+			return *p;
+		return default_value;
+	}
 
-	template<typename T> inline constexpr auto value_cast_object = impl::value_cast_object<T>;
+	template<typename T> inline T* value_cast_object(const impl::value& v)
+	{
+		return impl::value_cast_object<T>(v);
+	}
+	template<typename T> inline T* value_cast_object(const impl::value_ref& v)
+	{
+		return impl::value_cast_object<T>(v);
+	}
 
 	template<typename Base> inline constexpr auto is_base_of = impl::is_base_of<Base>;
+
+	template<typename... Args> constexpr type_id_t get_signature_id()
+	{
+		return impl::get_signature_id<Args...>();
+	}
 	
 	template<typename T, typename Object>
 	inline auto object_cast(Object* object)
@@ -1853,6 +7504,22 @@ namespace rtti
 			return impl::object_cast<target_type>(object);
 	}
 
+	// Name of the first enumerator which has value, or an empty string.
+	template<typename E, typename = std::enable_if_t<std::is_enum_v<E>>>
+	constexpr std::string_view enum_name(E value)
+	{
+		if (auto e = impl::type<E>::enumerators().get_by_value(static_cast<int64_t>(value)))
+			return e->name();
+		return {};
+	}
+	template<typename E, typename = std::enable_if_t<std::is_enum_v<E>>>
+	constexpr std::optional<E> enum_value(std::string_view name)
+	{
+		if (auto e = impl::type<E>::enumerators().get(name))
+			return static_cast<E>(e->value());
+		return std::nullopt;
+	}
+
 	template<typename Fn>
 	inline void visit_all_types(Fn&& f)
 	{
@@ -1872,17 +7539,11 @@ namespace rtti
 	}
 	inline const impl::type_view* get_type_view(const char* type_name)
 	{
-		auto type_id = impl::hash(type_name);
-		const impl::type_view* result = nullptr;
-		visit_all_types([&](auto& view) {
-			if (view.id() == type_id)
-			{
-				result = &view;
-				return false;
-			}
-			return true;
-		});
-		return result;
+		return impl::type_registry::instance().find(std::string_view(type_name));
+	}
+	inline const impl::type_view* get_type_view_by_id(type_id_t type_id)
+	{
+		return impl::type_registry::instance().find(type_id);
 	}
 
 	template<typename T> using type = impl::type<T>;
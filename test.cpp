@@ -2,12 +2,18 @@
 //
 
 #include "pch.h"
+#define RTTI_MAPPED_FILE
 #include "rtti.h"
 #include <iostream>
 #include <vector>
+#include <memory>
 #include <array>
+#include <map>
+#include <set>
 #include <any>
 #include <string>
+#include <thread>
+#include <chrono>
 
 
 #define CATCH_CONFIG_MAIN
@@ -27,6 +33,7 @@ struct Base
 {
 	Base() {}
 	Base(int val) { m_b_v0 = val; }
+	Base(const std::string& str) { m_string = str; }
 	virtual~Base() {}
 
 	int		m_b_v0 = 11;
@@ -41,6 +48,8 @@ struct Base
 	void set(const int& v) { m_modify_by_method = v; }
 
 	int method(int arg) { return arg*20; }
+	void add(int arg) { m_modify_by_method += arg; }
+	const std::string& text() const { return m_string; }
 
 	rtti_class_decl(Base);
 };
@@ -48,7 +57,8 @@ rtti_class_impl(Base,
 	.display_name("Base")
 	.constructors(
 		constructor<>(),
-		constructor<int>())
+		constructor<int>(),
+		constructor<std::string>())
 	.properties(
 		property("b_v0").member(&Base::m_b_v0),
 		property("string").member(&Base::m_string),
@@ -59,7 +69,14 @@ rtti_class_impl(Base,
 			+[](Base& o, const int& value) { o.m_b_v0 = value / 10; }))
 	.methods(
 		method("method").invoker(&Base::method),
-		method("delegate").invoker(+[](int value) { return value*30; })));
+		method("add").invoker(&Base::add),
+		method("text").invoker(&Base::text),
+		method("delegate").invoker(+[](int value) { return value*30; }),
+		method("length").invoker(+[](const char* text) { return static_cast<int>(std::strlen(text)); }),
+		method("scale").invoker(+[](int value) { return value*2; }),
+		method("scale").invoker(+[](float value) { return value*0.5f; }),
+		method("measure").invoker(+[](int value) { return value; }),
+		method("measure").invoker(+[](const Base* base) { return base->m_b_v0; })));
 
 struct MyAttribute : public rtti::attribute
 {
@@ -93,10 +110,275 @@ rtti_impl(MyClass2,
 	.properties(
 		property("value").member(&MyClass2::m_value)));
 
+struct Left
+{
+	int		m_left = 1;
+
+	rtti_class_decl(Left);
+};
+rtti_class_impl(Left,
+	.properties(
+		property("left").member(&Left::m_left)));
+
+struct Right
+{
+	int		m_right = 2;
+
+	rtti_class_decl(Right);
+};
+rtti_class_impl(Right,
+	.properties(
+		property("right").member(&Right::m_right)));
+
+struct Shared
+{
+	int		m_shared = 3;
+
+	rtti_class_decl(Shared);
+};
+rtti_class_impl(Shared,
+	.properties(
+		property("shared").member(&Shared::m_shared)));
+
+// Right and Shared are placed at nonzero offsets.
+struct Both : public Left, public Right, public virtual Shared
+{
+	int		m_both = 4;
+
+	rtti_class_decl(Both);
+};
+rtti_class_impl(Both,
+	.bases<Left, Right, Shared>()
+	.properties(
+		property("both").member(&Both::m_both)));
+
+struct Linked
+{
+	Right*	m_right = nullptr;
+};
+rtti_impl(Linked,
+	.properties(
+		property("right").member(&Linked::m_right)));
+
+// Trivially copyable, but its property is a pointer, so it is not serialized as bytes.
+struct Link
+{
+	Link*	m_next = nullptr;
+};
+rtti_impl(Link,
+	.properties(
+		property("next").member(&Link::m_next)));
+
+struct Chain
+{
+	int		m_id = 0;
+	Link	m_link;
+};
+rtti_impl(Chain,
+	.properties(
+		property("id").member(&Chain::m_id),
+		property("link").member(&Chain::m_link)));
+
+struct Gauge
+{
+	int		m_raw = 0;
+
+	rtti_class_decl(Gauge);
+};
+rtti_class_impl(Gauge,
+	.properties(
+		property("scaled").delegate(
+			+[](const Gauge& o) { return o.m_raw * 10; },
+			+[](Gauge& o, const int& value) { o.m_raw = value / 10; })));
+
+// Gauge is placed at a nonzero offset, and has no address of its property.
+struct Meter : public Left, public Gauge
+{
+	rtti_class_decl(Meter);
+};
+rtti_class_impl(Meter,
+	.bases<Left, Gauge>());
+
+// Throws from its constructor once budget objects are alive.
+struct Fragile
+{
+	inline static int live = 0;
+	inline static int budget = 0;
+
+	Fragile(int value)
+		: m_value(value)
+	{
+		if (live == budget)
+			throw std::runtime_error("fragile");
+		++live;
+	}
+	~Fragile() { --live; }
+
+	int		m_value;
+};
+rtti_impl(Fragile,
+	.constructors(
+		constructor<int>()));
+
+struct Holder
+{
+	std::unique_ptr<int>	m_pointer;
+	std::vector<int>		m_values;
+	std::string				m_name = "holder";
+
+	const std::vector<int>& values() const { return m_values; }
+	std::vector<int>& values() { return m_values; }
+	const std::string& name() const { return m_name; }
+};
+rtti_impl(Holder,
+	.properties(
+		property("pointer").member(&Holder::m_pointer),
+		property("values").member(&Holder::m_values),
+		property("items").member(&Holder::values, &Holder::values),
+		property("name").member(&Holder::name),
+		property("label").delegate(
+			+[](const Holder& o) -> const std::string& { return o.m_name; },
+			+[](Holder& o, const std::string& value) { o.m_name = value; })));
+
+// Registered by the "find" section only, after the type registry is built.
+struct LateRegistered
+{
+	int		m_value = 0;
+};
+
+// Elements without a default constructor, which a vector can not be resized with.
+struct NoDefault
+{
+	explicit NoDefault(int value) : m_value(value) {}
+	int		m_value;
+};
+struct Roster
+{
+	std::vector<NoDefault>	m_entries;
+};
+rtti_impl(Roster,
+	.properties(
+		property("entries").member(&Roster::m_entries)));
+
+// Read only through a getter, as it can not be assigned.
+struct Frozen
+{
+	const int	m_value = 5;
+};
+struct FrozenHolder
+{
+	Frozen	m_frozen;
+};
+rtti_impl(FrozenHolder,
+	.properties(
+		property("frozen").delegate(+[](const FrozenHolder& o) { return o.m_frozen; }),
+		property("frozen_ref").delegate(+[](const FrozenHolder& o) -> const Frozen& { return o.m_frozen; })));
+
+struct Tree
+{
+	int					m_value = 0;
+	std::vector<Tree>	m_children;
+};
+rtti_impl(Tree,
+	.properties(
+		property("value").member(&Tree::m_value),
+		property("children").member(&Tree::m_children)));
+
+// Serialized with a property which has a getter only.
+struct Tally
+{
+	int		m_count = 0;
+};
+rtti_impl(Tally,
+	.properties(
+		property("count").member(&Tally::m_count),
+		property("label").delegate(+[](const Tally& o) { return std::to_string(o.m_count); })));
+
+struct Catalog
+{
+	int				m_id = 0;
+	std::set<int>	m_keys;
+};
+rtti_impl(Catalog,
+	.properties(
+		property("id").member(&Catalog::m_id),
+		property("keys").member(&Catalog::m_keys)));
+
+enum class Color
+{
+	red, green, blue,
+};
+rtti_enum_impl(Color,
+	.enumerators(
+		enumerator("red", Color::red),
+		enumerator("green", Color::green),
+		enumerator("blue", Color::blue)));
+
+enum Access : unsigned
+{
+	access_none = 0,
+	access_read = 1,
+	access_write = 2,
+	access_execute = 8,
+	access_all = access_read | access_write | access_execute,
+};
+rtti_enum_impl(Access,
+	.display_name("Access")
+	.enumerators(
+		enumerator("none", access_none),
+		enumerator("read", access_read),
+		enumerator("write", access_write),
+		enumerator("execute", access_execute),
+		enumerator("all", access_all)));
+
+struct Record
+{
+	int					m_id = 0;
+	double				m_score = 0.5;
+	std::string			m_name;
+	std::vector<int>	m_tags;
+	Color				m_color = Color::red;
+	Access				m_access = access_none;
+	bool				m_active = false;
+};
+rtti_impl(Record,
+	.properties(
+		property("id").member(&Record::m_id),
+		property("score").member(&Record::m_score),
+		property("name").display_name("Name").member(&Record::m_name),
+		property("tags").member(&Record::m_tags),
+		property("color").member(&Record::m_color),
+		property("access").member(&Record::m_access),
+		property("active").member(&Record::m_active)));
+
 
 const auto& void_type = rtti::get_type_view<void>();
 
 
+// Counts the allocations and deallocations passed to the upstream resource.
+class counting_resource : public std::pmr::memory_resource
+{
+public:
+	size_t	allocations = 0;
+	size_t	deallocations = 0;
+
+private:
+	void* do_allocate(size_t bytes, size_t alignment) override
+	{
+		++allocations;
+		return std::pmr::get_default_resource()->allocate(bytes, alignment);
+	}
+	void do_deallocate(void* p, size_t bytes, size_t alignment) override
+	{
+		++deallocations;
+		std::pmr::get_default_resource()->deallocate(p, bytes, alignment);
+	}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+	{
+		return this == &other;
+	}
+};
+
 TEST_CASE("value", "[rtti]")
 {
 	SECTION("cast")
@@ -157,6 +439,170 @@ TEST_CASE("value", "[rtti]")
 		Base object2;
 		v = &object2;
 		CHECK(rtti::value_cast_object<MyClass>(v) == nullptr);
+
+		// A reference to a pointer refers the pointer, not the object.
+		MyClass* pointer = &object;
+		rtti::value_ref ref = pointer;
+		CHECK(ref.address() == &pointer);
+		CHECK(ref.type() == rtti::get_type_view<MyClass*>());
+
+		// The pointer holds the address of the Right subobject, so it is referred as Right*, not as the runtime Both*.
+		Both both;
+		Right* right = &both;
+		rtti::value_ref right_ref = right;
+		CHECK(right_ref.type() == rtti::get_type_view<Right*>());
+		CHECK(rtti::value_cast_object<Right>(right_ref) == right);
+		CHECK(rtti::value_cast_object<Both>(right_ref) == nullptr);
+
+		Linked linked = { right };
+		auto view = rtti::get_type_view<Linked>().properties().get("right")->view(&linked);
+		REQUIRE(view.has_value());
+		CHECK(view.type() == rtti::get_type_view<Right*>());
+		CHECK(rtti::value_cast_object<Right>(view) == right);
+		CHECK(rtti::value_cast_object<Right>(view)->m_right == 2);
+
+		// A mutable pointer is read as a pointer to const, as from a value.
+		CHECK(rtti::value_cast<Right*>(view) == &linked.m_right);
+		CHECK(rtti::value_cast<const Right*>(view) == &linked.m_right);
+		CHECK(*rtti::value_cast<const Right*>(view) == right);
+		CHECK(rtti::value_cast<const Right*>(ref) == nullptr);
+	}
+
+	SECTION("storage")
+	{
+		CHECK(rtti::value::is_inline<std::string>());
+		CHECK(!rtti::value::is_inline<std::array<char, rtti::value::inline_capacity + 1>>());
+
+		rtti::value v = std::string("abcd");
+		CHECK(v.is_inline());
+
+		rtti::value copied = v;
+		rtti::value moved = std::move(v);
+		CHECK(!v.has_value());
+		CHECK(rtti::value_cast<std::string>(copied, "").compare("abcd") == 0);
+		CHECK(rtti::value_cast<std::string>(moved, "").compare("abcd") == 0);
+
+		std::array<char, rtti::value::inline_capacity + 1> large = { 'x' };
+		v = large;
+		CHECK(!v.is_inline());
+		copied = v;
+		CHECK(rtti::value_cast<decltype(large)>(copied)->front() == 'x');
+
+		struct counter
+		{
+			int* count;
+			counter(int* p) : count(p) {}
+			counter(const counter& r) noexcept : count(r.count) {}
+			~counter() { ++*count; }
+		};
+		int destructed = 0;
+		{
+			rtti::value c = counter(&destructed);
+			destructed = 0;
+			CHECK(c.is_inline());
+		}
+		CHECK(destructed == 1);
+	}
+
+	SECTION("move only")
+	{
+		rtti::value v = std::make_unique<int>(5);
+		CHECK(**rtti::value_cast<std::unique_ptr<int>>(v) == 5);
+
+		rtti::value moved = std::move(v);
+		CHECK(!v.has_value());
+		CHECK(**rtti::value_cast<std::unique_ptr<int>>(moved) == 5);
+
+		CHECK(!moved.can_copy());
+		CHECK(rtti::value(5).can_copy());
+		CHECK(rtti::value().can_copy());
+
+		rtti::value target = 7;
+		CHECK(!target.copy_from(moved));
+		CHECK(rtti::value_cast<int>(target, 0) == 7);
+		CHECK(moved.has_value());
+		CHECK(target.copy_from(rtti::value(8)));
+		CHECK(rtti::value_cast<int>(target, 0) == 8);
+
+		// Copying it otherwise throws rather than leaving an empty copy.
+		CHECK_THROWS_AS([&] { rtti::value copy(moved); }(), std::logic_error);
+		CHECK_THROWS_AS(target = moved, std::logic_error);
+		CHECK(rtti::value_cast<int>(target, 0) == 8);
+	}
+
+	SECTION("memory resource")
+	{
+		rtti::arena_resource arena(256);
+		std::array<char, rtti::value::inline_capacity + 1> large = { 'x' };
+
+		{
+			rtti::value v0(std::allocator_arg, &arena, large);
+			CHECK(arena.used() == sizeof(large));
+
+			rtti::memory_resource_scope scope(arena);
+			rtti::value v1 = large;
+			rtti::value v2 = std::string("abcd");
+			CHECK(arena.used() == sizeof(large) * 2);
+			CHECK(rtti::value_cast<decltype(large)>(v1)->front() == 'x');
+		}
+
+		rtti::value v3 = large;
+		CHECK(arena.used() == sizeof(large) * 2);
+
+		arena.reset();
+		CHECK(arena.used() == 0);
+
+		for (int i = 0; i < 16; ++i)
+			rtti::value(std::allocator_arg, &arena, large);
+		CHECK(arena.used() == sizeof(large) * 16);
+	}
+
+	SECTION("throwing copy")
+	{
+		// Too large for the inline buffer, and throws when copied.
+		struct throwing_copy
+		{
+			std::array<char, rtti::value::inline_capacity + 1>	data = {};
+
+			throwing_copy() {}
+			throwing_copy(throwing_copy&&) = default;
+			throwing_copy(const throwing_copy&) { throw std::runtime_error("copy"); }
+		};
+
+		counting_resource counter;
+		{
+			rtti::memory_resource_scope scope(counter);
+			throwing_copy source;
+			CHECK_THROWS_AS(rtti::value(source), std::runtime_error);
+			CHECK(counter.deallocations == counter.allocations);
+
+			rtti::value moved = throwing_copy();
+			CHECK_THROWS_AS([&] { rtti::value copy(moved); }(), std::runtime_error);
+			CHECK(counter.deallocations + 1 == counter.allocations);
+		}
+		CHECK(counter.deallocations == counter.allocations);
+	}
+
+	SECTION("allocations")
+	{
+		counting_resource counter;
+		rtti::memory_resource_scope scope(counter);
+		std::array<char, rtti::value::inline_capacity + 1> large = { 'x' };
+		Base object;
+		auto property = object.rtti_type_view().properties().get("string");
+
+		rtti::value v;
+		for (int i = 0; i < 10; ++i)
+		{
+			v = 5;
+			v = property->get(&object);
+			v = object.m_string;
+		}
+		CHECK(counter.allocations == 0);
+
+		for (int i = 0; i < 10; ++i)
+			v = large;
+		CHECK(counter.allocations == 10);
 	}
 }
 
@@ -187,6 +633,31 @@ TEST_CASE("property", "[rtti]")
 		CHECK(*p1 == 2020);
 	}
 
+	SECTION("read only member")
+	{
+		FrozenHolder object;
+		auto property = rtti::get_type_view<FrozenHolder>().properties().get("frozen");
+		REQUIRE(property);
+		CHECK(property->is_read_only());
+		auto value = property->get(&object);
+		REQUIRE(rtti::value_cast<Frozen>(value));
+		CHECK(rtti::value_cast<Frozen>(value)->m_value == 5);
+
+		// Frozen can not be assigned, so it is not read without boxing.
+		Frozen frozen[1];
+		CHECK(!property->read(&object, frozen));
+		CHECK(!property->get_many(&object, 1, frozen));
+		rtti::property_handle<FrozenHolder, Frozen> handle(*property);
+		REQUIRE(handle);
+		CHECK(!handle.get(object, frozen[0]));
+		CHECK(!handle.set(object, frozen[0]));
+
+		auto ref = rtti::get_type_view<FrozenHolder>().properties().get("frozen_ref");
+		REQUIRE(ref);
+		CHECK(ref->is_referable());
+		CHECK(rtti::value_cast<Frozen>(ref->view(&object)) == &object.m_frozen);
+	}
+
 	SECTION("array member")
 	{
 		Base object;
@@ -221,6 +692,252 @@ TEST_CASE("property", "[rtti]")
 		CHECK(strcmp(pstr, "abcd") == 0);
 	}
 
+	SECTION("view")
+	{
+		Base object;
+
+		auto prop_str = object.rtti_type_view().properties().get("string");
+		auto view = prop_str->view(&object);
+		CHECK(view.has_value());
+		CHECK(!view.is_const());
+		CHECK(view.type().is<std::string>());
+		CHECK(rtti::value_cast<std::string>(view) == &object.m_string);
+		CHECK(rtti::value_cast_object<std::string>(view) == &object.m_string);
+
+		auto cview = prop_str->view(const_cast<const Base*>(&object));
+		CHECK(cview.is_const());
+		CHECK(rtti::value_cast<std::string>(cview) == &object.m_string);
+		CHECK(rtti::value_cast_object<std::string>(cview) == nullptr);
+		CHECK(rtti::value_cast_object<const std::string>(cview) == &object.m_string);
+
+		auto c_str_prop = view.type().properties().get("c_str");
+		auto pstr = rtti::value_cast<const char*>(c_str_prop->get(view.pointer()), "");
+		CHECK(pstr == object.m_string.c_str());
+
+		auto prop_array = object.rtti_type_view().properties().get("array");
+		CHECK(rtti::value_cast<int>(prop_array->view(&object, rtti::index{ 1, 2 })) == &object.m_array[1][2]);
+
+		auto prop_method = object.rtti_type_view().properties().get("method");
+		CHECK(!prop_method->view(&object).has_value());
+	}
+
+	SECTION("layout")
+	{
+		Base object;
+		auto& type = rtti::get_type_view<Base>();
+
+		auto v0 = type.properties().get("b_v0")->layout();
+		CHECK(v0.is_addressable());
+		CHECK(reinterpret_cast<char*>(&object) + v0.offset == reinterpret_cast<char*>(&object.m_b_v0));
+		CHECK(v0.element_size == sizeof(int));
+		CHECK(v0.rank() == 0);
+		CHECK(v0.count() == 1);
+		CHECK(v0.is_trivially_copyable);
+
+		auto array = type.properties().get("array")->layout();
+		CHECK(reinterpret_cast<char*>(&object) + array.offset == reinterpret_cast<char*>(&object.m_array));
+		CHECK(array.rank() == 2);
+		CHECK(*array.extents.begin() == 2);
+		CHECK(*(array.extents.begin() + 1) == 4);
+		CHECK(array.size() == sizeof(object.m_array));
+
+		auto str = type.properties().get("string")->layout();
+		CHECK(str.is_addressable());
+		CHECK(!str.is_trivially_copyable);
+
+		auto method = type.properties().get("method")->layout();
+		CHECK(!method.is_addressable());
+		CHECK(method.element_size == sizeof(int));
+	}
+
+	SECTION("slice")
+	{
+		Base object;
+		auto property = object.rtti_type_view().properties().get("array");
+
+		int row[4] = {};
+		CHECK(property->read_slice(&object, rtti::index{ 1 }, row, 4) == 4);
+		CHECK(row[0] == 21);
+		CHECK(row[3] == 24);
+
+		int all[8] = {};
+		CHECK(property->read_slice(&object, rtti::index<>(), all, 8) == 8);
+		CHECK(all[5] == 22);
+		CHECK(property->read_slice(&object, rtti::index{ 0, 2 }, all, 1) == 1);
+		CHECK(all[0] == 13);
+
+		CHECK(property->read_slice(&object, rtti::index<>(), all, 7) == 0);
+		CHECK(property->read_slice(&object, rtti::index{ 2 }, row, 4) == 0);
+		float floats[4];
+		CHECK(property->read_slice(&object, rtti::index{ 1 }, floats, 4) == 0);
+
+		const int values[4] = { 1, 2, 3, 4 };
+		CHECK(property->write_slice(&object, rtti::index{ 0 }, values, 4) == 4);
+		CHECK(object.m_array[0][3] == 4);
+		CHECK(object.m_array[1][0] == 21);
+
+		auto method = object.rtti_type_view().properties().get("method");
+		CHECK(method->read_slice(&object, rtti::index<>(), row, 4) == 0);
+	}
+
+	SECTION("many")
+	{
+		MyClass objects[3];
+		objects[1].m_v0 = 1;
+		objects[1].m_b_v0 = 2;
+		auto& type = rtti::get_type_view<MyClass>();
+		auto v0 = type.properties().get("v0");
+		auto b_v0 = type.properties().get("b_v0");
+		auto method = type.properties().get("method");
+
+		int values[3] = {};
+		CHECK(v0->get_many(objects, 3, values));
+		CHECK(values[1] == 1);
+		CHECK(b_v0->get_many(objects, 3, values));
+		CHECK(values[0] == 11);
+		CHECK(values[1] == 2);
+
+		const int inputs[3] = { 5, 6, 7 };
+		CHECK(method->set_many(objects, 3, inputs));
+		CHECK(objects[2].m_modify_by_method == 7);
+
+		rtti::value pointers[] = { &objects[0], static_cast<Base*>(&objects[2]) };
+		CHECK(b_v0->set_many(pointers, 2, inputs));
+		CHECK(objects[2].m_b_v0 == 6);
+		CHECK(method->get_many(pointers, 2, values));
+		CHECK(values[1] == 7);
+
+		const void* addresses[] = { static_cast<Base*>(&objects[1]) };
+		CHECK(b_v0->get_many(addresses, 1, values));
+		CHECK(values[0] == 2);
+
+		float floats[3];
+		CHECK(!v0->get_many(objects, 3, floats));
+		MyClass2 others[1];
+		CHECK(!v0->get_many(others, 1, values));
+		rtti::value constants[] = { const_cast<const MyClass*>(&objects[0]) };
+		CHECK(!v0->set_many(constants, 1, inputs));
+	}
+
+	SECTION("handle")
+	{
+		MyClass object;
+		auto& type = rtti::get_type_view<MyClass>();
+
+		rtti::property_handle<MyClass, int> v0(*type.properties().get("v0"));
+		REQUIRE(v0);
+		CHECK(v0.is_direct());
+		CHECK(v0.get(object) == 22);
+		CHECK(v0.set(object, 23));
+		CHECK(object.m_v0 == 23);
+
+		rtti::property_handle<MyClass, int> b_v0(*type.properties().get("b_v0"));
+		CHECK(b_v0.is_direct());
+		CHECK(b_v0.get(object) == 11);
+
+		rtti::property_handle<MyClass, int> method(*type.properties().get("method"));
+		REQUIRE(method);
+		CHECK(!method.is_direct());
+		CHECK(method.get(object) == 50);
+		CHECK(method.set(object, 150));
+		CHECK(object.m_modify_by_method == 150);
+		int read = 0;
+		CHECK(method.get(object, read));
+		CHECK(read == 150);
+
+		Holder holder;
+		rtti::property_handle<Holder, std::string> name(*rtti::get_type_view<Holder>().properties().get("name"));
+		REQUIRE(name);
+		CHECK(!name.set(holder, "renamed"));
+		CHECK(name.get(holder) == "holder");
+
+		CHECK(!rtti::property_handle<MyClass, float>(*type.properties().get("v0")));
+		CHECK(!rtti::property_handle<MyClass, int>(*type.properties().get("array")));
+		CHECK(!rtti::property_handle<MyClass2, int>(*type.properties().get("v0")));
+
+		Both both;
+		auto& both_type = rtti::get_type_view<Both>();
+		rtti::property_handle<Both, int> right(*both_type.properties().get("right"));
+		CHECK(right.is_direct());
+		CHECK(right.get(both) == 2);
+
+		rtti::property_handle<Both, int> shared(*both_type.properties().get("shared"));
+		REQUIRE(shared);
+		CHECK(!shared.is_direct());
+		shared.set(both, 30);
+		CHECK(shared.get(both) == 30);
+		CHECK(both.m_shared == 30);
+	}
+
+	SECTION("move")
+	{
+		Holder object;
+		auto& type = rtti::get_type_view<Holder>();
+
+		auto pointer = type.properties().get("pointer");
+		CHECK(!pointer->is_read_only());
+		CHECK(pointer->set(&object, rtti::value(std::make_unique<int>(7))));
+		REQUIRE(object.m_pointer);
+		CHECK(*object.m_pointer == 7);
+
+		// A move-only value is not copied from a value the caller keeps.
+		const rtti::value kept = std::make_unique<int>(8);
+		CHECK(!pointer->set(&object, kept));
+		CHECK(*object.m_pointer == 7);
+		CHECK(**rtti::value_cast<std::unique_ptr<int>>(kept) == 8);
+
+		// Nor is it written without boxing, which can only copy.
+		auto replacement = std::make_unique<int>(9);
+		CHECK(!pointer->write(&object, &replacement));
+		CHECK(!pointer->set_many(&object, 1, &replacement));
+		rtti::property_handle<Holder, std::unique_ptr<int>> handle(*pointer);
+		REQUIRE(handle);
+		CHECK(!handle.set(object, replacement));
+		CHECK(*object.m_pointer == 7);
+		CHECK(*replacement == 9);
+		CHECK(!pointer->get(&object).has_value());
+		CHECK(rtti::value_cast<std::unique_ptr<int>>(pointer->view(&object)) == &object.m_pointer);
+
+		rtti::value values = std::vector<int>(100, 1);
+		auto data = rtti::value_cast<std::vector<int>>(values)->data();
+		type.properties().get("values")->set(&object, std::move(values));
+		CHECK(object.m_values.data() == data);
+	}
+
+	SECTION("reference getter")
+	{
+		Holder object;
+		object.m_values = { 1, 2, 3 };
+		auto& type = rtti::get_type_view<Holder>();
+
+		auto items = type.properties().get("items");
+		CHECK(items->is_referable());
+		CHECK(!items->is_read_only());
+		CHECK(rtti::value_cast<std::vector<int>*>(items->ref(&object), nullptr) == &object.m_values);
+		CHECK(rtti::value_cast<std::vector<int>>(items->view(&object)) == &object.m_values);
+		CHECK(rtti::value_cast<std::vector<int>>(items->get(&object))->size() == 3);
+		items->set(&object, std::vector<int>(5));
+		CHECK(object.m_values.size() == 5);
+
+		auto name = type.properties().get("name");
+		CHECK(name->is_referable());
+		CHECK(name->is_read_only());
+		CHECK(rtti::value_cast<std::string*>(name->ref(&object), nullptr) == nullptr);
+		CHECK(rtti::value_cast<const std::string*>(name->cref(&object), nullptr) == &object.m_name);
+		auto view = name->view(&object);
+		CHECK(view.is_const());
+		CHECK(rtti::value_cast<std::string>(view) == &object.m_name);
+
+		auto label = type.properties().get("label");
+		CHECK(label->is_referable());
+		CHECK(rtti::value_cast<std::string>(label->view(&object)) == &object.m_name);
+		label->set(&object, std::string("label"));
+		CHECK(object.m_name == "label");
+
+		CHECK(type.properties().get("values")->is_referable());
+		CHECK(!rtti::get_type_view<Base>().properties().get("method")->is_referable());
+	}
+
 	SECTION("method")
 	{
 		Base object;
@@ -298,6 +1015,99 @@ TEST_CASE("method", "[rtti]")
 	auto args = method1->arguments_type();
 	CHECK(args.size() == 1);
 	CHECK(args.begin()->is<int>());
+
+	auto method2 = object.rtti_type_view().methods().get("add");
+	CHECK(!method2->invoke(&object, { 5 }).has_value());
+	CHECK(object.m_modify_by_method == 55);
+
+	SECTION("overload")
+	{
+		auto methods = object.rtti_type_view().methods();
+		auto scale_int = methods.get("scale", rtti::get_signature_id<int>());
+		auto scale_float = methods.get("scale", rtti::get_signature_id<float>());
+		REQUIRE(scale_int);
+		REQUIRE(scale_float);
+		CHECK(scale_int != scale_float);
+		CHECK(scale_float->result_type().is<float>());
+		CHECK(methods.get("scale", rtti::get_signature_id<double>()) == nullptr);
+
+		CHECK(rtti::value_cast<int>(methods.invoke("scale", nullptr, { 3 }), 0) == 6);
+		CHECK(rtti::value_cast<float>(methods.invoke("scale", nullptr, { 3.0f }), 0.0f) == 1.5f);
+		CHECK(rtti::value_cast<int>(methods.invoke("method", &object, { 2 }), 0) == 40);
+		CHECK(!methods.invoke("unknown", &object, { 2 }).has_value());
+
+		// A Base* matches no overload exactly, and is accepted by the const Base* overload declared after the int one.
+		CHECK(methods.get("measure", rtti::get_signature_id<Base*>()) == nullptr);
+		CHECK(!methods.get("measure")->is_invocable(nullptr, { &object }));
+		CHECK(rtti::value_cast<int>(methods.invoke("measure", nullptr, { &object }), 0) == 11);
+		CHECK(rtti::value_cast<int>(methods.invoke("measure", nullptr, { 7 }), 0) == 7);
+		CHECK(!methods.invoke("measure", nullptr, { 1.0f }).has_value());
+		CHECK(!methods.invoke("measure", nullptr, { 1, 2 }).has_value());
+
+		CHECK(scale_float->invoke_as<float>(nullptr, 3.0f) == 1.5f);
+	}
+
+	SECTION("invoke_as")
+	{
+		MyClass derived;
+
+		CHECK(method0->invoke_as<int>(&object, 30) == 600);
+		CHECK(method0->invoke_as<int>(&derived, 2) == 40);
+		CHECK(method1->invoke_as<int>(nullptr, 40) == 1200);
+		CHECK(method2->invoke_as<void>(&object, 5));
+		CHECK(object.m_modify_by_method == 60);
+
+		CHECK(!method0->invoke_as<int>(&object, 30.0f));
+		CHECK(!method0->invoke_as<float>(&object, 30));
+		CHECK(!method0->invoke_as<int>(&object));
+		CHECK(!method0->invoke_as<int>(nullptr, 30));
+		CHECK(!method0->invoke_as<int>(const_cast<const Base*>(&object), 30));
+		MyClass2 other;
+		CHECK(!method0->invoke_as<int>(&other, 30));
+
+		// A string literal is passed as the pointer it decays to.
+		auto length = object.rtti_type_view().methods().get("length");
+		REQUIRE(length);
+		CHECK(length->invoke_as<int>(nullptr, "abcde") == 5);
+		const char* text_pointer = "abc";
+		CHECK(length->invoke_as<int>(nullptr, text_pointer) == 3);
+		CHECK(length->is_invocable_as<int, const char*>());
+
+		// A const member function which returns a reference is invoked on const objects, and its result is copied.
+		auto text = object.rtti_type_view().methods().get("text");
+		REQUIRE(text);
+		CHECK(text->is_const());
+		CHECK(!method0->is_const());
+		const Base& constant = object;
+		CHECK(text->invoke_as<std::string>(&constant) == std::string("abcd"));
+		CHECK(text->invoke_as<const std::string&>(&object) == std::string("abcd"));
+		CHECK(rtti::value_cast<std::string>(text->invoke(&constant, {}), "") == "abcd");
+		CHECK(rtti::bound_method<std::string()>(*text, &constant)() == "abcd");
+	}
+
+	SECTION("bound_method")
+	{
+		rtti::bound_method<int(int)> bound0(*method0, &object);
+		REQUIRE(bound0);
+		CHECK(bound0(30) == 600);
+
+		MyClass derived;
+		rtti::bound_method<int(int)> unbound0(*method0);
+		CHECK(unbound0.invoke(&derived, 2) == 40);
+		CHECK(unbound0(2) == 0);
+		MyClass2 other;
+		CHECK(unbound0.invoke(&other, 2) == 0);
+
+		rtti::bound_method<int(int)> bound1(*method1);
+		CHECK(bound1(40) == 1200);
+
+		rtti::bound_method<void(int)> bound2(*method2, &object);
+		bound2(5);
+		CHECK(object.m_modify_by_method == 60);
+
+		CHECK(!rtti::bound_method<int(float)>(*method0, &object));
+		CHECK(!rtti::bound_method<int(int)>(*method0, &other));
+	}
 }
 
 TEST_CASE("construction", "[rtti]")
@@ -316,6 +1126,303 @@ TEST_CASE("construction", "[rtti]")
 
 	auto p2 = rtti::value_cast_object<Base>(base_type.instantiate({ nullptr }));
 	CHECK(p2 == nullptr);
+
+	auto p4 = rtti::value_cast_object<Base>(base_type.instantiate({ std::string("xyz") }));
+	CHECK(p4);
+	CHECK(p4->m_string == "xyz");
+	delete p4;
+
+	auto ctor = base_type.constructors().begin() + 1;
+	CHECK(ctor->signature_id() == rtti::get_signature_id<int>());
+
+	CHECK(base_type.size() == sizeof(Base));
+	CHECK(base_type.alignment() == alignof(Base));
+	CHECK(rtti::get_type_view<void>().size() == 0);
+
+	alignas(Base) unsigned char storage[sizeof(Base) * 3];
+	auto r = base_type.instantiate_at(storage, { 55 });
+	REQUIRE(r.has_value());
+	CHECK(rtti::value_cast_object<Base>(r) == reinterpret_cast<Base*>(storage));
+	CHECK(reinterpret_cast<Base*>(storage)->m_b_v0 == 55);
+	base_type.destroy(storage);
+
+	CHECK(!base_type.instantiate_at(storage, { 1.0f }).has_value());
+	CHECK(!base_type.instantiate_at(nullptr, { 55 }).has_value());
+	CHECK(!base_type.instantiate_n(nullptr, 3, { 55 }));
+
+	CHECK(base_type.instantiate_n(storage, 3, { std::string("xyz") }));
+	CHECK(reinterpret_cast<Base*>(storage)[2].m_string == "xyz");
+	base_type.destroy_n(storage, 3);
+
+	rtti::arena_resource arena;
+	auto p3 = rtti::value_cast_object<Base>(base_type.instantiate(&arena, { 77 }));
+	CHECK(p3);
+	CHECK(p3->m_b_v0 == 77);
+	CHECK(arena.used() == sizeof(Base));
+	p3->~Base();
+
+	{
+		// The scope does not take the ownership of objects from instantiate(args), which are deleted by the caller.
+		rtti::memory_resource_scope scope(arena);
+		auto p5 = rtti::value_cast_object<Base>(base_type.instantiate({ 88 }));
+		CHECK(p5);
+		CHECK(p5->m_b_v0 == 88);
+		CHECK(arena.used() == sizeof(Base));
+		delete p5;
+	}
+
+	auto& fragile_type = rtti::get_type_view<Fragile>();
+	alignas(Fragile) unsigned char fragile_storage[sizeof(Fragile) * 4];
+	Fragile::budget = 2;
+	CHECK_THROWS(fragile_type.instantiate_n(fragile_storage, 4, { 1 }));
+	CHECK(Fragile::live == 0);
+	Fragile::budget = 4;
+	CHECK(fragile_type.instantiate_n(fragile_storage, 4, { 1 }));
+	CHECK(Fragile::live == 4);
+	fragile_type.destroy_n(fragile_storage, 4);
+	CHECK(Fragile::live == 0);
+
+	// The memory taken from the resource is returned when the constructor throws.
+	counting_resource counter;
+	Fragile::budget = 0;
+	CHECK_THROWS(fragile_type.instantiate(&counter, { 1 }));
+	CHECK(counter.allocations == 1);
+	CHECK(counter.deallocations == 1);
+}
+
+TEST_CASE("container", "[rtti]")
+{
+	SECTION("sequence")
+	{
+		std::vector<int> values = { 1, 2, 3 };
+		auto container = rtti::get_type_view<std::vector<int>>().container();
+		REQUIRE(container);
+		CHECK(container->element_type().is<int>());
+		CHECK(container->key_type().is<void>());
+		CHECK(container->is_contiguous());
+		CHECK(container->size(&values) == 3);
+		CHECK(container->data(&values) == values.data());
+		CHECK(rtti::value_cast<int>(container->at(&values, 1)) == &values[1]);
+		CHECK(!container->at(&values, 3).has_value());
+		CHECK(container->at(const_cast<const std::vector<int>*>(&values), 0).is_const());
+
+		CHECK(container->insert(&values, 4));
+		CHECK(!container->insert(&values, 4.0f));
+		CHECK(values.back() == 4);
+		CHECK(container->reserve(&values, 100));
+		CHECK(values.capacity() >= 100);
+
+		int sum = 0;
+		for (auto cursor = container->begin(&values); !cursor.is_end(); cursor.next())
+			sum += *rtti::value_cast<int>(cursor.get());
+		CHECK(sum == 10);
+
+		auto cursor = container->begin(&values);
+		CHECK(container->erase(&values, cursor));
+		CHECK(*rtti::value_cast<int>(cursor.get()) == 2);
+		CHECK(values.size() == 3);
+
+		CHECK(container->resize(&values, 5));
+		CHECK(values.size() == 5);
+		container->clear(&values);
+		CHECK(values.empty());
+
+		std::array<float, 4> fixed = {};
+		auto array = rtti::get_type_view<std::array<float, 4>>().container();
+		REQUIRE(array);
+		CHECK(array->is_contiguous());
+		CHECK(!array->insert(&fixed, 1.0f));
+		CHECK(!array->reserve(&fixed, 8));
+
+		CHECK(!rtti::get_type_view<Base>().container());
+		CHECK(!rtti::get_type_view<int>().container());
+		CHECK(!rtti::get_type_view<std::vector<bool>>().container());
+
+		// Move-only elements are not inserted, as values are copied in.
+		std::vector<std::unique_ptr<int>> pointers;
+		auto move_only = rtti::get_type_view<decltype(pointers)>().container();
+		REQUIRE(move_only);
+		CHECK(!move_only->insert(&pointers, rtti::value()));
+		std::map<int, std::unique_ptr<int>> owners;
+		CHECK(!rtti::get_type_view<decltype(owners)>().container()->insert(&owners, 1, rtti::value()));
+
+		// Elements without a default constructor are inserted and erased, but not resized.
+		Roster roster;
+		roster.m_entries.emplace_back(7);
+		auto entries = rtti::get_type_view<Roster>().properties().get("entries")->view(&roster).type().container();
+		REQUIRE(entries);
+		CHECK(!entries->resize(&roster.m_entries, 4));
+		CHECK(entries->insert(&roster.m_entries, NoDefault(8)));
+		CHECK(roster.m_entries.size() == 2);
+		auto entry = entries->begin(&roster.m_entries);
+		CHECK(entries->erase(&roster.m_entries, entry));
+		CHECK(roster.m_entries.front().m_value == 8);
+
+		// Elements which can not be assigned are not shifted in a vector.
+		std::vector<Frozen> frozen(2);
+		auto frozen_container = rtti::get_type_view<decltype(frozen)>().container();
+		REQUIRE(frozen_container);
+		CHECK(!frozen_container->insert(&frozen, Frozen()));
+		auto frozen_entry = frozen_container->begin(&frozen);
+		CHECK(!frozen_container->erase(&frozen, frozen_entry));
+		CHECK(frozen_container->resize(&frozen, 3));
+	}
+
+	SECTION("associative")
+	{
+		std::map<std::string, int> map;
+		auto container = rtti::get_type_view<decltype(map)>().container();
+		REQUIRE(container);
+		CHECK(container->is_associative());
+		CHECK(!container->is_random_access());
+		CHECK(container->key_type().is<std::string>());
+		CHECK(container->mapped_type().is<int>());
+
+		CHECK(container->insert(&map, std::string("b"), 2));
+		CHECK(container->insert(&map, std::pair<const std::string, int>("a", 1)));
+		CHECK(!container->insert(&map, 1, 2));
+		CHECK(map.size() == 2);
+		CHECK(rtti::value_cast<int>(container->find(&map, std::string("b"))) == &map["b"]);
+		CHECK(!container->find(&map, std::string("c")).has_value());
+
+		auto cursor = container->begin(&map);
+		CHECK(cursor.key().is_const());
+		CHECK(*rtti::value_cast<std::string>(cursor.key()) == "a");
+		CHECK(!cursor.mapped().is_const());
+		CHECK(rtti::value_cast<int>(cursor.mapped()) == &map["a"]);
+
+		std::set<int> set = { 3, 1 };
+		auto set_container = rtti::get_type_view<decltype(set)>().container();
+		REQUIRE(set_container);
+		CHECK(set_container->begin(&set).get().is_const());
+		CHECK(rtti::value_cast<int>(set_container->find(&set, 3)) == &*set.find(3));
+	}
+
+	SECTION("property")
+	{
+		Holder object;
+		object.m_values = { 5, 6 };
+		auto view = rtti::get_type_view<Holder>().properties().get("values")->view(&object);
+		auto container = view.type().container();
+		REQUIRE(container);
+		CHECK(container->size(view.address()) == 2);
+		CHECK(container->data(view.address()) == object.m_values.data());
+	}
+}
+
+TEST_CASE("object pool", "[rtti]")
+{
+	rtti::object_pool pool(rtti::get_type_view<Base>(), 16);
+
+	std::vector<Base*> objects;
+	for (int i = 0; i < 40; ++i)
+	{
+		auto object = rtti::value_cast_object<Base>(pool.create({ i }));
+		REQUIRE(object);
+		CHECK(object->m_b_v0 == i);
+		objects.push_back(object);
+	}
+	auto stats = pool.stats();
+	CHECK(stats.live_count == 40);
+	CHECK(stats.capacity >= 40);
+	CHECK(stats.capacity == stats.slab_count * 16);
+
+	CHECK(!pool.create({ 1.0f }).has_value());
+	CHECK(pool.stats().live_count == 40);
+
+	// A throwing constructor returns the slot, so the pool does not grow by failed constructions.
+	rtti::object_pool fragile_pool(rtti::get_type_view<Fragile>(), 16);
+	Fragile::budget = Fragile::live;
+	for (int i = 0; i < 40; ++i)
+		CHECK_THROWS(fragile_pool.create({ i }));
+	CHECK(fragile_pool.stats().live_count == 0);
+	CHECK(fragile_pool.stats().slab_count == 1);
+
+	for (auto object : objects)
+		pool.destroy(object);
+	CHECK(pool.stats().live_count == 0);
+
+	for (int i = 0; i < 40; ++i)
+		objects[i] = rtti::value_cast_object<Base>(pool.create({}));
+	CHECK(pool.stats().slab_count == stats.slab_count);
+	for (auto object : objects)
+		pool.destroy(object);
+
+	SECTION("threads")
+	{
+		std::vector<Base*> kept[4];
+		std::vector<std::thread> threads;
+		for (auto& local : kept)
+		{
+			threads.emplace_back([&pool, &local]()
+			{
+				for (int i = 0; i < 1000; ++i)
+				{
+					auto object = rtti::value_cast_object<Base>(pool.create({ i }));
+					if (i % 2)
+						pool.destroy(object);
+					else
+						local.push_back(object);
+				}
+			});
+		}
+		for (auto& thread : threads)
+			thread.join();
+		CHECK(pool.stats().live_count == 500 * 4);
+
+		for (auto& local : kept)
+		{
+			for (auto object : local)
+				pool.destroy(object);
+		}
+		CHECK(pool.stats().live_count == 0);
+	}
+
+	SECTION("thread exit")
+	{
+		rtti::object_pool slab_pool(rtti::get_type_view<Base>(), 64);
+		std::thread([&]()
+		{
+			slab_pool.destroy(rtti::value_cast_object<Base>(slab_pool.create({})));
+		}).join();
+
+		// The slots cached by the thread are back in the pool, so one slab holds all objects.
+		std::vector<Base*> slab_objects;
+		for (int i = 0; i < 64; ++i)
+			slab_objects.push_back(rtti::value_cast_object<Base>(slab_pool.create({ i })));
+		CHECK(slab_pool.stats().slab_count == 1);
+		for (auto object : slab_objects)
+			slab_pool.destroy(object);
+
+		Base* kept = nullptr;
+		std::thread([&]()
+		{
+			kept = rtti::value_cast_object<Base>(slab_pool.create({}));
+		}).join();
+		CHECK(slab_pool.stats().live_count == 1);
+		slab_pool.destroy(kept);
+		CHECK(slab_pool.stats().live_count == 0);
+	}
+
+	SECTION("many pools")
+	{
+		std::vector<std::unique_ptr<rtti::object_pool>> pools;
+		for (int i = 0; i < 20; ++i)
+			pools.push_back(std::make_unique<rtti::object_pool>(rtti::get_type_view<Base>(), 4));
+		for (int round = 0; round < 3; ++round)
+		{
+			for (int i = 0; i < 20; ++i)
+			{
+				auto object = rtti::value_cast_object<Base>(pools[i]->create({ i }));
+				CHECK(object->m_b_v0 == i);
+				pools[i]->destroy(object);
+			}
+		}
+		for (auto& p : pools)
+			CHECK(p->stats().live_count == 0);
+	}
+
+	CHECK(&rtti::object_pool::of(rtti::get_type_view<Base>()) == &rtti::object_pool::of(rtti::get_type_view<Base>()));
 }
 
 TEST_CASE("meta", "[rtti]")
@@ -402,6 +1509,9 @@ TEST_CASE("meta", "[rtti]")
 		{
 			CHECK(base.display_name().compare("Base") == 0);
 		}
+		CHECK(type.ancestors().size() == 1);
+		CHECK(*type.ancestors().begin() == rtti::get_type_view<Base>().id());
+		CHECK(rtti::get_type_view<Base>().ancestors().size() == 0);
 
 		auto props = type.properties();
 		CHECK(type.properties().size() == 6);
@@ -414,6 +1524,10 @@ TEST_CASE("meta", "[rtti]")
 		CHECK(prop_v0);
 		CHECK(prop_v0->value_type().name().compare("int") == 0);
 
+		CHECK(props.get("unknown") == nullptr);
+		CHECK(type.methods().get("method"));
+		CHECK(type.methods().get("unknown") == nullptr);
+
 		auto attr = type.attributes().get<MyAttribute>();
 		CHECK(attr);
 		CHECK(attr->description.compare("myattribute") == 0);
@@ -427,27 +1541,1498 @@ TEST_CASE("meta", "[rtti]")
 				++count;
 				return true;
 		});
-		CHECK(count == 4);
+		CHECK(count == 26);
+	}
+
+	SECTION("find")
+	{
+		auto& type = rtti::get_type_view<MyClass>();
+		CHECK(rtti::get_type_view(std::string(type.name()).c_str()) == &type);
+		CHECK(rtti::get_type_view_by_id(type.id()) == &type);
+		CHECK(rtti::get_type_view_by_id(rtti::get_type_view<MyClass2>().id()) == &rtti::get_type_view<MyClass2>());
+		CHECK(rtti::get_type_view("unregistered") == nullptr);
+		CHECK(rtti::get_type_view_by_id(rtti::get_type_view<float>().id()) == nullptr);
+
+		// Types registered after the registry is built are added to it.
+		auto& registry = rtti::impl::type_registry::instance();
+		auto size = registry.size();
+		CHECK(rtti::get_type_view_by_id(rtti::get_type_view<LateRegistered>().id()) == nullptr);
+		static const rtti::impl::type_view_chain late = { rtti::get_type_view<LateRegistered>() };
+		CHECK(rtti::get_type_view_by_id(rtti::get_type_view<LateRegistered>().id()) == &rtti::get_type_view<LateRegistered>());
+		CHECK(registry.size() == size + 1);
+		CHECK(rtti::get_type_view_by_id(rtti::get_type_view<double>().id()) == nullptr);
 	}
 }
 
-TEST_CASE("cast", "[rtti]")
+TEST_CASE("enum", "[rtti]")
 {
-	MyClass myclass;
-	Base base;
+	SECTION("enumerators")
+	{
+		auto& type = rtti::get_type_view<Color>();
+		CHECK(type.is_enum());
+		CHECK(!rtti::get_type_view<Base>().is_enum());
+		CHECK(type.enumerators().size() == 3);
+		CHECK(type.enumerators().begin()->name() == "red");
+
+		auto green = type.enumerators().get("green");
+		REQUIRE(green);
+		CHECK(green->value() == static_cast<int64_t>(Color::green));
+		CHECK(type.enumerators().get("purple") == nullptr);
+		CHECK(type.enumerators().get_by_value(2)->name() == "blue");
+		CHECK(type.enumerators().get_by_value(3) == nullptr);
+		CHECK(type.enumerators().get_by_value(-1) == nullptr);
+
+		CHECK(rtti::enum_name(Color::blue) == "blue");
+		CHECK(rtti::enum_value<Color>("green") == Color::green);
+		CHECK(!rtti::enum_value<Color>("Green"));
+		CHECK(rtti::get_type_view<Base>().enumerators().get("red") == nullptr);
+	}
 
-	MyClass* cast0 = rtti::object_cast<MyClass>(&base);
-	CHECK(cast0 == nullptr);
-	
-	Base* cast1 = rtti::object_cast<Base>(&myclass);
-	CHECK(cast1 != nullptr);
+	SECTION("flags")
+	{
+		auto& type = rtti::get_type_view<Access>();
+		CHECK(type.display_name() == "Access");
+		CHECK(rtti::enum_name(access_write) == "write");
+		CHECK(type.enumerators().get_by_value(4) == nullptr);
+
+		std::string text;
+		CHECK(type.enumerators().format_flags(access_read | access_execute, text));
+		CHECK(text == "read|execute");
+		CHECK(type.enumerators().format_flags(access_none, text));
+		CHECK(text == "none");
+		CHECK(!type.enumerators().format_flags(access_read | 4, text));
+		CHECK(text == "read");
+
+		int64_t value = 0;
+		CHECK(type.enumerators().parse_flags("write | execute", value));
+		CHECK(value == (access_write | access_execute));
+		CHECK(type.enumerators().parse_flags("all", value));
+		CHECK(value == access_all);
+		CHECK(!type.enumerators().parse_flags("read|delete", value));
+	}
+}
 
-	MyClass* cast2 = rtti::object_cast<MyClass>(cast1);
-	CHECK(cast2 != nullptr);
+TEST_CASE("binary serialization", "[rtti]")
+{
+	SECTION("round trip")
+	{
+		MyClass source;
+		source.m_v0 = 5;
+		source.m_b_v0 = 7;
+		source.m_string = "serialized";
+		source.m_array[1][2] = 9;
+		source.m_modify_by_method = 77;
+
+		rtti::binary_writer writer;
+		REQUIRE(writer.write(source));
+
+		MyClass target;
+		rtti::binary_reader reader(writer.data(), writer.size());
+		CHECK(reader.read(target));
+		CHECK(reader.remaining() == 0);
+		CHECK(target.m_v0 == 5);
+		CHECK(target.m_b_v0 == 7);
+		CHECK(target.m_string == "serialized");
+		CHECK(target.m_array[1][2] == 9);
+		CHECK(target.m_modify_by_method == 77);
+
+		MyClass truncated;
+		rtti::binary_reader short_reader(writer.data(), writer.size() - 1);
+		CHECK(!short_reader.read(truncated));
+	}
 
-	const Base* cast3 = rtti::object_cast<Base>((const MyClass*)&myclass);
-	CHECK(cast3 != nullptr);
+	SECTION("bases")
+	{
+		Both source;
+		source.m_left = 10;
+		source.m_right = 20;
+		source.m_shared = 30;
+		source.m_both = 40;
+
+		rtti::binary_writer writer;
+		REQUIRE(writer.write(source));
+		CHECK(writer.size() == sizeof(int) * 4);
+
+		Both target;
+		rtti::binary_reader reader(writer.data(), writer.size());
+		CHECK(reader.read(target));
+		CHECK(target.m_left == 10);
+		CHECK(target.m_right == 20);
+		CHECK(target.m_shared == 30);
+		CHECK(target.m_both == 40);
+
+		Meter meter;
+		meter.m_left = 5;
+		meter.m_raw = 7;
+		rtti::binary_writer meter_writer;
+		REQUIRE(meter_writer.write(meter));
+
+		Meter meter_target;
+		rtti::binary_reader meter_reader(meter_writer.data(), meter_writer.size());
+		CHECK(meter_reader.read(meter_target));
+		CHECK(meter_target.m_left == 5);
+		CHECK(meter_target.m_raw == 7);
+	}
+
+	SECTION("read only accessor")
+	{
+		Tally source;
+		source.m_count = 12;
+		rtti::binary_writer writer;
+		REQUIRE(writer.write(source));
+
+		// The label is written, and skipped on read as it has no setter.
+		Tally target;
+		rtti::binary_reader reader(writer.data(), writer.size());
+		CHECK(reader.read(target));
+		CHECK(reader.remaining() == 0);
+		CHECK(target.m_count == 12);
+	}
+
+	SECTION("plan")
+	{
+		using opcode = rtti::serialization_plan::opcode;
+
+		auto& plan = rtti::serialization_plan::of(rtti::get_type_view<MyClass>());
+		CHECK(&plan == &rtti::serialization_plan::of(rtti::get_type_view<MyClass>()));
+		CHECK(plan.is_valid());
+		std::vector<opcode> codes;
+		for (auto& op : plan.operations())
+			codes.push_back(op.code);
+		CHECK(codes == std::vector<opcode>{ opcode::copy, opcode::container, opcode::copy, opcode::accessor, opcode::accessor, opcode::copy });
+
+		auto& both = rtti::serialization_plan::of(rtti::get_type_view<Both>());
+		CHECK(std::any_of(both.operations().begin(), both.operations().end(), [](auto& op) { return op.code == opcode::rebase; }));
+
+		CHECK(!rtti::serialization_plan::of(rtti::get_type_view<std::map<int, int>>()).is_valid());
+		CHECK(!rtti::serialization_plan::of(rtti::get_type_view<int*>()).is_valid());
+
+		CHECK(!rtti::serialization_plan::is_raw(rtti::get_type_view<Link>()));
+		CHECK(!rtti::serialization_plan::of(rtti::get_type_view<Chain>()).is_valid());
+		CHECK(rtti::serialization_plan::is_raw(rtti::get_type_view<MyClass2>()));
+	}
+
+	SECTION("nested pointers")
+	{
+		Link tail;
+		Chain chain;
+		chain.m_link.m_next = &tail;
+		std::vector<Link> links(2, chain.m_link);
+		std::array<Link, 2> fixed_links = {};
+
+		rtti::binary_writer writer;
+		CHECK(!writer.write(chain));
+		writer.clear();
+		CHECK(!writer.write(links));
+		writer.clear();
+		CHECK(!writer.write(fixed_links));
+	}
+
+	SECTION("containers")
+	{
+		std::vector<std::string> source = { "a", "bc", "" };
+		rtti::binary_writer writer;
+		REQUIRE(writer.write(source));
+
+		std::vector<std::string> target;
+		rtti::binary_reader reader(writer.data(), writer.size());
+		CHECK(reader.read(target));
+		CHECK(target == source);
+
+		std::map<int, int> map;
+		CHECK(!writer.write(map));
+		Holder holder;
+		CHECK(!writer.write(holder));
+		Catalog catalog;
+		catalog.m_keys = { 10, 20, 30 };
+		CHECK(!writer.write(catalog));
+		CHECK(!rtti::serialization_plan::of(rtti::get_type_view<Catalog>()).is_valid());
+		const MyClass constant;
+		CHECK(!reader.read(constant));
+	}
+}
+
+TEST_CASE("json", "[rtti]")
+{
+	SECTION("round trip")
+	{
+		Record source;
+		source.m_id = 7;
+		source.m_score = 0.1;
+		source.m_name = "quote \" and\nline";
+		source.m_tags = { 1, 2, 3 };
+		source.m_color = Color::blue;
+		source.m_access = Access(access_read | access_write);
+		source.m_active = true;
+
+		rtti::json_writer writer;
+		REQUIRE(writer.write(source));
+		CHECK(writer.text() == R"({"id":7,"score":0.1,"name":"quote \" and\nline","tags":[1,2,3],"color":"blue","access":"read|write","active":true})");
+
+		Record target;
+		rtti::json_reader reader(writer.text());
+		CHECK(reader.read(target));
+		CHECK(reader.is_end());
+		CHECK(target.m_id == 7);
+		CHECK(target.m_score == 0.1);
+		CHECK(target.m_name == source.m_name);
+		CHECK(target.m_tags == source.m_tags);
+		CHECK(target.m_color == Color::blue);
+		CHECK(target.m_access == (access_read | access_write));
+		CHECK(target.m_active);
+	}
+
+	SECTION("keys")
+	{
+		Record target;
+		rtti::json_reader reader(R"( { "Name" : "\u00e9\ud83d\ude00", "unknown": { "a": [ 1, { "b": "]" } ] }, "id": -3, "color": 2 } )");
+		CHECK(reader.read(target));
+		CHECK(target.m_name == "\xC3\xA9\xF0\x9F\x98\x80");
+		CHECK(target.m_id == -3);
+		CHECK(target.m_color == Color::blue);
+		CHECK(target.m_score == 0.5);
+
+		auto& binding = rtti::json_binding::of(rtti::get_type_view<Record>());
+		CHECK(&binding == &rtti::json_binding::of(rtti::get_type_view<Record>()));
+		CHECK(binding.kind() == rtti::json_kind::object);
+		CHECK(binding.find("name") == binding.find("Name"));
+		CHECK(binding.find("missing") == nullptr);
+	}
+
+	SECTION("classes")
+	{
+		MyClass2 simple;
+		rtti::json_writer writer;
+		REQUIRE(writer.write(simple));
+		CHECK(writer.text() == R"({"value":33})");
+
+		MyClass source;
+		source.m_v0 = 5;
+		source.m_b_v0 = 7;
+		source.m_array[1][2] = 9;
+		source.m_modify_by_method = 77;
+		writer.clear();
+		REQUIRE(writer.write(source));
+
+		MyClass target;
+		CHECK(rtti::json_reader(writer.text()).read(target));
+		CHECK(target.m_v0 == 5);
+		CHECK(target.m_b_v0 == 7);
+		CHECK(target.m_array[1][2] == 9);
+		CHECK(target.m_modify_by_method == 77);
+
+		Both both;
+		both.m_shared = 30;
+		writer.clear();
+		REQUIRE(writer.write(both));
+		CHECK(writer.text().find(R"("shared":30)") != std::string_view::npos);
+		Both both_target;
+		CHECK(rtti::json_reader(writer.text()).read(both_target));
+		CHECK(both_target.m_shared == 30);
+	}
+
+	SECTION("structural index")
+	{
+		// Escapes and a long string, shifted so that they cross the 64 byte blocks at every offset.
+		std::string body = R"({"a":[1, 2.5e3,true], "b\\":"x\"y\\\\", "long":")" + std::string(100, 'z') + R"(\\\"", "c" : null})";
+		for (size_t shift = 0; shift < 64; ++shift)
+		{
+			auto text = std::string(shift, ' ') + body;
+			std::vector<uint32_t> expected;
+			bool in_string = false;
+			bool in_scalar = false;
+			for (size_t i = 0; i < text.size(); ++i)
+			{
+				auto c = text[i];
+				if (in_string)
+				{
+					if (c == '\\')
+						++i;
+					else if (c == '"')
+					{
+						expected.push_back((uint32_t)i);
+						in_string = false;
+					}
+				}
+				else if (c == '"' || std::string_view("{}[]:,").find(c) != std::string_view::npos)
+				{
+					expected.push_back((uint32_t)i);
+					in_string = c == '"';
+					in_scalar = false;
+				}
+				else if (c == ' ')
+					in_scalar = false;
+				else if (!std::exchange(in_scalar, true))
+					expected.push_back((uint32_t)i);
+			}
+
+			for (auto level : { rtti::simd_level::scalar, rtti::simd_level::sse2, rtti::simd_level::avx2 })
+			{
+				rtti::json_structural_index index(text, level);
+				CHECK(index.is_valid());
+				CHECK(std::vector<uint32_t>(index.positions(), index.positions() + index.size()) == expected);
+			}
+		}
+
+		CHECK(!rtti::json_structural_index("\"abc").is_valid());
+		CHECK(!rtti::json_structural_index("\"a\nb\"").is_valid());
+	}
+
+	SECTION("numbers")
+	{
+		std::vector<int64_t> integers;
+		CHECK(rtti::json_reader("[0, -1, 12345678901234567, -9223372036854775808, 9223372036854775807]").read(integers));
+		CHECK(integers == std::vector<int64_t>{ 0, -1, 12345678901234567, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max() });
+		CHECK(!rtti::json_reader("[9223372036854775808]").read(integers));
+		std::vector<uint8_t> bytes;
+		CHECK(rtti::json_reader("[255]").read(bytes));
+		CHECK(!rtti::json_reader("[256]").read(bytes));
+		CHECK(!rtti::json_reader("[-1]").read(bytes));
+
+		auto join = [](const std::vector<std::string>& samples)
+		{
+			std::string text;
+			for (auto& sample : samples)
+				text += (text.empty() ? "[" : ",") + sample;
+			return text + "]";
+		};
+		std::vector<std::string> samples = { "0.1", "-2.5e-3", "1e22", "123456789012345678901", "1.7976931348623157e308", "4.9e-324", "16777217" };
+		std::vector<double> doubles;
+		REQUIRE(rtti::json_reader(join(samples)).read(doubles));
+		for (size_t i = 0; i < samples.size(); ++i)
+			CHECK(doubles[i] == std::strtod(samples[i].c_str(), nullptr));
+
+		samples = { "0.1", "-2.5e-3", "1e10", "3.4028235e38", "16777217", "1.17549435e-38" };
+		std::vector<float> floats;
+		REQUIRE(rtti::json_reader(join(samples)).read(floats));
+		for (size_t i = 0; i < samples.size(); ++i)
+			CHECK(floats[i] == std::strtof(samples[i].c_str(), nullptr));
+		CHECK(!rtti::json_reader("[1e39]").read(floats));
+
+		// Tokens which std::from_chars takes but JSON does not.
+		for (auto text : { "[inf]", "[-inf]", "[nan]", "[infinity]", "[1.]", "[.5]", "[-.5]", "[+1]", "[01]", "[-01]", "[1e]", "[1e+]", "[1.5e]", "[-]", "[0x10]" })
+		{
+			CHECK(!rtti::json_reader(text).read(doubles));
+			CHECK(!rtti::json_reader(text).read(integers));
+		}
+		CHECK(rtti::json_reader("[0, -0, 0.5, -0.0e+1, 1E2, 12.5e-30]").read(doubles));
+		CHECK(doubles == std::vector<double>{ 0.0, -0.0, 0.5, -0.0, 100.0, 12.5e-30 });
+	}
+
+	SECTION("errors")
+	{
+		Record target;
+		CHECK(!rtti::json_reader(R"({"id":1e3})").read(target));
+		CHECK(!rtti::json_reader(R"({"id":99999999999})").read(target));
+		CHECK(!rtti::json_reader(R"({"color":"purple"})").read(target));
+		CHECK(!rtti::json_reader(R"({"id":1)").read(target));
+		CHECK(!rtti::json_reader(R"({"name":"\ud83d"})").read(target));
+
+		rtti::json_writer writer;
+		std::map<int, int> map;
+		CHECK(!writer.write(map));
+		Holder holder;
+		CHECK(!writer.write(holder));
+		std::vector<double> values = { std::numeric_limits<double>::infinity() };
+		CHECK(!writer.write(values));
+		const MyClass constant;
+		CHECK(!rtti::json_reader("{}").read(constant));
+	}
+}
+
+TEST_CASE("archive", "[rtti]")
+{
+	auto& record_type = rtti::get_type_view<Record>();
+
+	SECTION("in place")
+	{
+		Record source;
+		source.m_id = 7;
+		source.m_score = 0.1;
+		source.m_name = "archived";
+		source.m_tags = { 1, 2, 3 };
+		source.m_color = Color::blue;
+		source.m_active = true;
+
+		rtti::archive_writer writer;
+		REQUIRE(writer.write(source));
+
+		rtti::archive_view<Record> view(writer.data(), writer.size());
+		REQUIRE(view.has_value());
+		CHECK(view.kind() == rtti::archive_kind::object);
+		CHECK(*view["id"].as<int>() == 7);
+		CHECK(*view["score"].as<double>() == 0.1);
+		CHECK(view["Name"].string() == "archived");
+		CHECK(view["tags"].size() == 3);
+		CHECK(view["tags"].data<int>()[2] == 3);
+		CHECK(*view["tags"][1].as<int>() == 2);
+		CHECK(*view["color"].as<Color>() == Color::blue);
+		CHECK(view["missing"].has_value() == false);
+		CHECK(view["id"].as<double>() == nullptr);
+
+		// Accessors like those of property_view.
+		auto& id = *record_type.properties().get("id");
+		auto& name = *record_type.properties().get("name");
+		CHECK(view.view(id).address() == view["id"].address());
+		CHECK(view.get<int>(id) == 7);
+		CHECK(view.get<std::string>(name) == "archived");
+		CHECK(view.get<double>(id) == 0);
+		CHECK(!view.view(name).has_value());
+		std::string text;
+		CHECK(view.read(name, &text));
+		CHECK(text == "archived");
+
+		Record target;
+		CHECK(view.load(target));
+		CHECK(target.m_id == 7);
+		CHECK(target.m_score == 0.1);
+		CHECK(target.m_name == "archived");
+		CHECK(target.m_tags == source.m_tags);
+		CHECK(target.m_color == Color::blue);
+		CHECK(target.m_active);
+	}
+
+	SECTION("classes")
+	{
+		MyClass source;
+		source.m_v0 = 5;
+		source.m_b_v0 = 7;
+		source.m_string = "archived";
+		source.m_array[1][2] = 9;
+		source.m_modify_by_method = 77;
+
+		rtti::archive_writer writer;
+		REQUIRE(writer.write(source));
+		rtti::archive_view<MyClass> view(writer.data(), writer.size());
+		REQUIRE(view.has_value());
+		CHECK(view["array"].is_array());
+		CHECK(view["array"].size() == 8);
+		CHECK(*view["array"][6].as<int>() == 9);
+		CHECK(*view["method"].as<int>() == 77);
+		CHECK(*view["delegate"].as<int>() == 70);
+
+		MyClass target;
+		CHECK(view.load(target));
+		CHECK(target.m_v0 == 5);
+		CHECK(target.m_b_v0 == 7);
+		CHECK(target.m_string == "archived");
+		CHECK(target.m_array[1][2] == 9);
+		CHECK(target.m_modify_by_method == 77);
+
+		Both both;
+		both.m_shared = 30;
+		REQUIRE(writer.write(both));
+		rtti::archive_view<Both> both_view(writer.data(), writer.size());
+		CHECK(*both_view["shared"].as<int>() == 30);
+		Both both_target;
+		CHECK(both_view.load(both_target));
+		CHECK(both_target.m_shared == 30);
+	}
+
+	SECTION("string table")
+	{
+		std::vector<std::string> source = { "shared", "other", "shared", "" };
+		rtti::archive_writer writer;
+		REQUIRE(writer.write(source));
+		auto view = rtti::archive_ref::open(writer.data(), writer.size(), rtti::get_type_view<std::vector<std::string>>());
+		REQUIRE(view.size() == 4);
+		CHECK(view[0].string() == "shared");
+		CHECK(view[0].string().data() == view[2].string().data());
+		CHECK(view[0].string().data()[6] == '\0');
+		CHECK(view[3].string().empty());
+
+		std::vector<std::string> target;
+		CHECK(view.load(target));
+		CHECK(target == source);
+	}
+
+	SECTION("recursive types")
+	{
+		Tree source;
+		source.m_value = 1;
+		source.m_children.resize(2);
+		source.m_children[1].m_value = 3;
+		source.m_children[1].m_children.resize(1);
+		source.m_children[1].m_children[0].m_value = 4;
+
+		rtti::archive_writer writer;
+		REQUIRE(writer.write(source));
+		rtti::archive_view<Tree> view(writer.data(), writer.size());
+		REQUIRE(view.has_value());
+		CHECK(*view["children"][1]["children"][0]["value"].as<int>() == 4);
+
+		Tree target;
+		CHECK(view.load(target));
+		CHECK(target.m_children[1].m_children[0].m_value == 4);
+
+		// The signature covers the layout of the elements, down to the type itself.
+		auto& layout = rtti::archive_layout::of(rtti::get_type_view<Tree>());
+		CHECK(layout.signature() != rtti::archive_layout::of(rtti::get_type_view<std::vector<Tree>>()).signature());
+		CHECK(rtti::archive_layout::of(rtti::get_type_view<std::vector<Record>>()).signature()
+			!= rtti::archive_layout::of(rtti::get_type_view<std::vector<Tree>>()).signature());
+
+		// Fields are found for properties of the type, and not for those of another type.
+		auto value_property = rtti::get_type_view<Tree>().properties().get("value");
+		REQUIRE(layout.find(*value_property));
+		CHECK(layout.find(*value_property)->property == value_property);
+		CHECK(layout.find(*rtti::get_type_view<Record>().properties().begin()) == nullptr);
+	}
+
+	SECTION("mapped file")
+	{
+		std::vector<Record> records(100);
+		for (int i = 0; i < (int)records.size(); ++i)
+		{
+			records[i].m_id = i;
+			records[i].m_name = "record " + std::to_string(i);
+		}
+		rtti::archive_writer writer;
+		REQUIRE(writer.write(records));
+		const char* path = "rtti_archive_test.bin";
+		REQUIRE(writer.save(path));
+		{
+			rtti::mapped_file file(path);
+			REQUIRE(file.is_open());
+			CHECK(file.size() == writer.size());
+			rtti::archive_view<std::vector<Record>> view(file.data(), file.size());
+			REQUIRE(view.size() == 100);
+			CHECK(*view[42]["id"].as<int>() == 42);
+			CHECK(view[99]["name"].string() == "record 99");
+		}
+		std::remove(path);
+		CHECK(!rtti::mapped_file(path).is_open());
+	}
+
+	SECTION("errors")
+	{
+		Record source;
+		source.m_tags = { 1, 2, 3 };
+		rtti::archive_writer writer;
+		REQUIRE(writer.write(source));
+		CHECK(!rtti::archive_view<Record>(writer.data(), writer.size() - 1).has_value());
+		CHECK(!rtti::archive_view<MyClass2>(writer.data(), writer.size()).has_value());
+
+		// A span which points out of the archive is followed to nothing.
+		std::vector<std::max_align_t> copy(writer.size() / sizeof(std::max_align_t) + 1);
+		std::memcpy(copy.data(), writer.data(), writer.size());
+		rtti::archive_view<Record> view(copy.data(), writer.size());
+		auto tags = const_cast<char*>(static_cast<const char*>(view["tags"].address()));
+		int64_t offset = 1 << 20;
+		std::memcpy(tags, &offset, sizeof(offset));
+		CHECK(view["tags"].size() == 0);
+		CHECK(view["tags"].data<int>() == nullptr);
+		Record target;
+		CHECK(!view.load(target));
+
+		std::map<int, int> map;
+		CHECK(!writer.write(map));
+		CHECK(writer.size() == 0);
+		Holder holder;
+		CHECK(!writer.write(holder));
+		CHECK(!rtti::archive_layout::of(rtti::get_type_view<int*>()).is_valid());
+	}
+}
+
+TEST_CASE("cast", "[rtti]")
+{
+	MyClass myclass;
+	Base base;
+
+	MyClass* cast0 = rtti::object_cast<MyClass>(&base);
+	CHECK(cast0 == nullptr);
+	
+	Base* cast1 = rtti::object_cast<Base>(&myclass);
+	CHECK(cast1 != nullptr);
+
+	MyClass* cast2 = rtti::object_cast<MyClass>(cast1);
+	CHECK(cast2 != nullptr);
+
+	const Base* cast3 = rtti::object_cast<Base>((const MyClass*)&myclass);
+	CHECK(cast3 != nullptr);
 
 	const MyClass* cast4 = rtti::object_cast<MyClass>(cast3);
 	CHECK(cast4 != nullptr);
-}
\ No newline at end of file
+}
+
+TEST_CASE("multiple inheritance cast", "[rtti]")
+{
+	Both object;
+	Left* left = &object;
+	Right* right = &object;
+	Shared* shared = &object;
+	REQUIRE(static_cast<void*>(right) != static_cast<void*>(&object));
+
+	SECTION("object_cast")
+	{
+		for (int i = 0; i < 2; ++i)
+		{
+			CHECK(rtti::object_cast<Right>(left) == right);
+			CHECK(rtti::object_cast<Left>(right) == left);
+			CHECK(rtti::object_cast<Shared>(right) == shared);
+			CHECK(rtti::object_cast<Both>(shared) == &object);
+			CHECK(rtti::object_cast<Right>(static_cast<const Left*>(left)) == right);
+		}
+
+		Right other;
+		CHECK(rtti::object_cast<Left>(&other) == nullptr);
+	}
+
+	SECTION("value")
+	{
+		rtti::value v = right;
+		CHECK(v.type() == rtti::get_type_view<Both*>());
+		CHECK(rtti::value_cast_object<Right>(v) == right);
+		CHECK(rtti::value_cast_object<Shared>(v) == shared);
+		CHECK(rtti::value_cast_object<Both>(v) == &object);
+
+		rtti::value_ref r = *shared;
+		CHECK(rtti::value_cast_object<Left>(r) == left);
+		CHECK(rtti::value_cast_object<Right>(r) == right);
+	}
+
+	SECTION("property")
+	{
+		auto& type = rtti::get_type_view<Both>();
+		CHECK(rtti::value_cast<int>(type.properties().get("left")->get(&object), 0) == 1);
+		CHECK(rtti::value_cast<int>(type.properties().get("right")->get(&object), 0) == 2);
+		CHECK(rtti::value_cast<int>(type.properties().get("shared")->get(&object), 0) == 3);
+		CHECK(rtti::value_cast<int>(type.properties().get("both")->get(&object), 0) == 4);
+
+		type.properties().get("shared")->set(right, 30);
+		CHECK(object.m_shared == 30);
+	}
+}
+
+TEST_CASE("value benchmark", "[rtti][!benchmark]")
+{
+	constexpr int count = 100000;
+
+	// std::string padded out of the inline buffer, which still takes the heap path.
+	struct padded_string
+	{
+		std::string		string = "abcd";
+		char			padding[rtti::value::inline_capacity] = {};
+	};
+
+	Base object;
+	padded_string padded;
+	auto property = object.rtti_type_view().properties().get("string");
+
+	CHECK(property->get(&object).is_inline());
+	CHECK(!rtti::value(padded).is_inline());
+
+	rtti::value v;
+
+	// Allocations of rtti::value in one run of a benchmark loop.
+	auto allocations = [&](auto&& run)
+	{
+		counting_resource counter;
+		rtti::memory_resource_scope scope(counter);
+		run();
+		v.reset();
+		return counter.allocations;
+	};
+	CHECK(allocations([&]() { for (int i = 0; i < count; ++i) v = property->get(&object); }) == 0);
+	CHECK(allocations([&]() { for (int i = 0; i < count; ++i) v = object.m_string; }) == 0);
+	CHECK(allocations([&]() { for (int i = 0; i < count; ++i) v = padded; }) == count);
+
+	BENCHMARK("get std::string property (inline)")
+	{
+		for (int i = 0; i < count; ++i)
+			v = property->get(&object);
+	}
+
+	BENCHMARK("assign std::string (inline)")
+	{
+		for (int i = 0; i < count; ++i)
+			v = object.m_string;
+	}
+
+	BENCHMARK("assign padded std::string (heap)")
+	{
+		for (int i = 0; i < count; ++i)
+			v = padded;
+	}
+
+	rtti::arena_resource arena;
+	auto assign_in_arena = [&]()
+	{
+		rtti::memory_resource_scope scope(arena);
+		for (int i = 0; i < count; ++i)
+			v = padded;
+		v.reset();
+		arena.reset();
+	};
+	assign_in_arena();
+
+	BENCHMARK("assign padded std::string (arena)")
+	{
+		assign_in_arena();
+	}
+}
+
+
+template<size_t Size>
+void benchmark_name_lookup()
+{
+	struct named
+	{
+		std::string_view	m_name;
+		std::string_view name() const { return m_name; }
+	};
+
+	std::vector<std::string> names;
+	for (size_t i = 0; i < Size; ++i)
+		names.push_back("property_" + std::to_string(i));
+	std::array<named, Size> items;
+	for (size_t i = 0; i < Size; ++i)
+		items[i].m_name = names[i];
+
+	rtti::impl::name_index<Size> index(items.data());
+	auto begin = items.data();
+	auto end = items.data() + Size;
+	auto last = names.back();
+
+	CHECK(rtti::impl::find_by_name(begin, end, index.data(), last) == end - 1);
+	CHECK(rtti::impl::find_by_name(begin, end, nullptr, last) == end - 1);
+
+	size_t found = 0;
+	BENCHMARK("linear lookup of " + std::to_string(Size) + " names")
+	{
+		for (auto& name : names)
+			found += rtti::impl::find_by_name(begin, end, nullptr, name) != end;
+	}
+	BENCHMARK("indexed lookup of " + std::to_string(Size) + " names")
+	{
+		for (auto& name : names)
+			found += rtti::impl::find_by_name(begin, end, index.data(), name) != end;
+	}
+	CHECK(found % Size == 0);
+}
+
+TEST_CASE("name lookup benchmark", "[rtti][!benchmark]")
+{
+	benchmark_name_lookup<8>();
+	benchmark_name_lookup<64>();
+	benchmark_name_lookup<512>();
+}
+
+TEST_CASE("type registry benchmark", "[rtti][!benchmark]")
+{
+	std::vector<rtti::type_id_t> ids;
+	rtti::visit_all_types([&](const rtti::type_view& type) { ids.push_back(type.id()); return true; });
+	auto& registry = rtti::impl::type_registry::instance();
+	CHECK(registry.size() > 0);
+	auto missing = rtti::impl::hash("unregistered");
+
+	// Lookups of every registered type and of a missing one, by the chain which get_type_view_by_id used to walk.
+	size_t found = 0;
+	BENCHMARK("type_view_chain walk of " + std::to_string(ids.size()) + " types")
+	{
+		for (auto id : ids)
+		{
+			for (auto chain = rtti::impl::type_view_chain::root(); chain; chain = chain->next())
+			{
+				if (chain->view().id() == id)
+				{
+					++found;
+					break;
+				}
+			}
+		}
+		for (auto chain = rtti::impl::type_view_chain::root(); chain; chain = chain->next())
+			found += chain->view().id() == missing;
+	}
+	BENCHMARK("type_registry find of " + std::to_string(ids.size()) + " types")
+	{
+		for (auto id : ids)
+			found += registry.find(id) != nullptr;
+		found += registry.find(missing) != nullptr;
+	}
+	CHECK(found > 0);
+
+	// The same lookups at 10k types, in the table type_registry holds and a chain of the same ids.
+	constexpr size_t count = 10000;
+	struct node
+	{
+		rtti::type_id_t		id;
+		const node*			next;
+	};
+	std::vector<node> nodes(count);
+	rtti::impl::type_id_table table;
+	for (size_t i = 0; i < count; ++i)
+	{
+		auto id = rtti::impl::hash("type_" + std::to_string(i));
+		nodes[i] = { id, i + 1 < count ? &nodes[i + 1] : nullptr };
+		table.insert(id, rtti::get_type_view<int>());
+	}
+	REQUIRE(table.size() == count);
+
+	size_t found_10k = 0;
+	BENCHMARK("chain walk of 100 of 10k types")
+	{
+		for (size_t i = 0; i < count; i += 100)
+		{
+			for (const node* p = &nodes[0]; p; p = p->next)
+			{
+				if (p->id == nodes[i].id)
+				{
+					++found_10k;
+					break;
+				}
+			}
+		}
+	}
+	BENCHMARK("type_id_table find of 100 of 10k types")
+	{
+		for (size_t i = 0; i < count; i += 100)
+			found_10k += table.find(nodes[i].id) != nullptr;
+	}
+	BENCHMARK("type_id_table find of all 10k types and 10k missing ids")
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			found_10k += table.find(nodes[i].id) != nullptr;
+			found_10k += table.find(nodes[i].id ^ missing) != nullptr;
+		}
+	}
+	CHECK(found_10k % (count / 100) == 0);
+}
+
+
+template<int Depth> struct DeepClass : public DeepClass<Depth - 1> {};
+template<> struct DeepClass<0> {};
+
+template<int Depth> struct rtti::impl::meta<DeepClass<Depth>>
+{
+	inline static constexpr auto description = meta_description<DeepClass<Depth>>::template initialize<>(get_type_name<DeepClass<Depth>>()).template bases<DeepClass<Depth - 1>>();
+};
+template<> struct rtti::impl::meta<DeepClass<0>>
+{
+	inline static constexpr auto description = meta_description<DeepClass<0>>::initialize<>(get_type_name<DeepClass<0>>());
+};
+
+bool is_base_of_recursive(const rtti::type_view& base_type, const rtti::type_view& derived_type)
+{
+	if (base_type.id() == derived_type.id())
+		return true;
+	for (auto& derived_base : derived_type.bases())
+	{
+		if (is_base_of_recursive(base_type, derived_base))
+			return true;
+	}
+	return false;
+}
+
+template<int Depth>
+void benchmark_is_base_of()
+{
+	constexpr int count = 10000;
+
+	auto& root = rtti::get_type_view<DeepClass<0>>();
+	auto& leaf = rtti::get_type_view<DeepClass<Depth>>();
+	CHECK(leaf.ancestors().size() == Depth);
+	CHECK(rtti::impl::is_base_of(root, leaf));
+	CHECK(!rtti::impl::is_base_of(leaf, root));
+
+	size_t found = 0;
+	BENCHMARK("recursive is_base_of at depth " + std::to_string(Depth))
+	{
+		for (int i = 0; i < count; ++i)
+			found += is_base_of_recursive(root, leaf);
+	}
+	BENCHMARK("ancestor table is_base_of at depth " + std::to_string(Depth))
+	{
+		for (int i = 0; i < count; ++i)
+			found += rtti::impl::is_base_of(root, leaf);
+	}
+	CHECK(found % count == 0);
+}
+
+TEST_CASE("is_base_of benchmark", "[rtti][!benchmark]")
+{
+	benchmark_is_base_of<1>();
+	benchmark_is_base_of<4>();
+	benchmark_is_base_of<16>();
+}
+
+TEST_CASE("object_cast benchmark", "[rtti][!benchmark]")
+{
+	constexpr int count = 10000;
+
+	Both object;
+	Left* left = &object;
+	auto& from_type = rtti::get_type_view<Both>();
+	auto& to_type = rtti::get_type_view<Right>();
+
+	uintptr_t sum = 0;
+	BENCHMARK("cross-cast by walking bases")
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			bool is_fixed = true;
+			sum += reinterpret_cast<uintptr_t>(rtti::impl::upcast_path(&object, from_type, to_type, is_fixed));
+		}
+	}
+	BENCHMARK("cross-cast with cached offset")
+	{
+		for (int i = 0; i < count; ++i)
+			sum += reinterpret_cast<uintptr_t>(rtti::object_cast<Right>(left));
+	}
+	CHECK(sum != 0);
+}
+
+TEST_CASE("property handle benchmark", "[rtti][!benchmark]")
+{
+	constexpr int count = 100000;
+
+	MyClass object;
+	auto property = rtti::get_type_view<MyClass>().properties().get("v0");
+	rtti::property_handle<MyClass, int> handle(*property);
+
+	int sum = 0;
+	BENCHMARK("property_view get and set")
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			sum += rtti::value_cast<int>(property->get(&object), 0);
+			property->set(&object, i);
+		}
+	}
+	BENCHMARK("property_handle get and set")
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			sum += handle.get(object);
+			handle.set(object, i);
+		}
+	}
+	CHECK(sum != 0);
+}
+
+TEST_CASE("property batch benchmark", "[rtti][!benchmark]")
+{
+	constexpr size_t count = 100000;
+
+	std::vector<MyClass> objects(count);
+	std::vector<int> values(count);
+	auto property = rtti::get_type_view<MyClass>().properties().get("v0");
+
+	BENCHMARK("property_view get per object")
+	{
+		for (size_t i = 0; i < count; ++i)
+			values[i] = rtti::value_cast<int>(property->get(&objects[i]), 0);
+	}
+	BENCHMARK("property_view get_many")
+	{
+		property->get_many(objects.data(), count, values.data());
+	}
+	BENCHMARK("property_view set per object")
+	{
+		for (size_t i = 0; i < count; ++i)
+			property->set(&objects[i], values[i]);
+	}
+	BENCHMARK("property_view set_many")
+	{
+		property->set_many(objects.data(), count, values.data());
+	}
+	CHECK(values[0] == 22);
+}
+
+TEST_CASE("method benchmark", "[rtti][!benchmark]")
+{
+	constexpr int count = 100000;
+
+	Base object;
+	auto method = object.rtti_type_view().methods().get("method");
+
+	int sum = 0;
+	BENCHMARK("method_view invoke")
+	{
+		for (int i = 0; i < count; ++i)
+			sum += rtti::value_cast<int>(method->invoke(&object, { i }), 0);
+	}
+	BENCHMARK("method_view invoke_as")
+	{
+		for (int i = 0; i < count; ++i)
+			sum += *method->invoke_as<int>(&object, i);
+	}
+	rtti::bound_method<int(int)> bound(*method, &object);
+	BENCHMARK("bound_method")
+	{
+		for (int i = 0; i < count; ++i)
+			sum += bound(i);
+	}
+	// Through a function pointer, so the call is not inlined away.
+	int(*volatile direct)(Base&, int) = [](Base& o, int arg) { return o.method(arg); };
+	BENCHMARK("direct call")
+	{
+		for (int i = 0; i < count; ++i)
+			sum += direct(object, i);
+	}
+	CHECK(sum != 0);
+}
+
+struct Grid
+{
+	float	m_cells[64][64] = {};
+};
+rtti_impl(Grid,
+	.properties(
+		property("cells").member(&Grid::m_cells)));
+
+TEST_CASE("array slice benchmark", "[rtti][!benchmark]")
+{
+	Grid grid;
+	grid.m_cells[63][63] = 1.0f;
+	auto property = rtti::get_type_view<Grid>().properties().get("cells");
+	std::vector<float> cells(64 * 64);
+
+	BENCHMARK("property_view get per element")
+	{
+		for (size_t y = 0; y < 64; ++y)
+		{
+			for (size_t x = 0; x < 64; ++x)
+				cells[y * 64 + x] = rtti::value_cast<float>(property->get(&grid, rtti::index{ y, x }), 0.0f);
+		}
+	}
+	BENCHMARK("property_view read_slice per row")
+	{
+		for (size_t y = 0; y < 64; ++y)
+			property->read_slice(&grid, rtti::index{ y }, &cells[y * 64], 64);
+	}
+	BENCHMARK("property_view read_slice")
+	{
+		property->read_slice(&grid, rtti::index<>(), cells.data(), cells.size());
+	}
+	CHECK(cells.back() == 1.0f);
+}
+
+TEST_CASE("container benchmark", "[rtti][!benchmark]")
+{
+	Holder object;
+	object.m_values.resize(4096, 1);
+	auto property = rtti::get_type_view<Holder>().properties().get("values");
+	auto container = property->value_type().container();
+	int sum = 0;
+
+	BENCHMARK("property_view get")
+	{
+		auto values = property->get(&object);
+		for (auto v : *rtti::value_cast<std::vector<int>>(values))
+			sum += v;
+	}
+	BENCHMARK("container_cursor")
+	{
+		auto view = property->view(&object);
+		for (auto cursor = container->begin(view.address()); !cursor.is_end(); cursor.next())
+			sum += *rtti::value_cast<int>(cursor.get());
+	}
+	BENCHMARK("container_view data")
+	{
+		auto view = property->view(&object);
+		auto data = static_cast<const int*>(container->data(view.address()));
+		for (size_t i = 0, size = container->size(view.address()); i < size; ++i)
+			sum += data[i];
+	}
+	CHECK(sum > 0);
+}
+
+enum class Opcode
+{
+	nop, load, store, add, sub, mul, div, jump, branch, call, ret, push, pop, compare, shift, halt,
+};
+rtti_enum_impl(Opcode,
+	.enumerators(
+		enumerator("nop", Opcode::nop), enumerator("load", Opcode::load), enumerator("store", Opcode::store),
+		enumerator("add", Opcode::add), enumerator("sub", Opcode::sub), enumerator("mul", Opcode::mul),
+		enumerator("div", Opcode::div), enumerator("jump", Opcode::jump), enumerator("branch", Opcode::branch),
+		enumerator("call", Opcode::call), enumerator("ret", Opcode::ret), enumerator("push", Opcode::push),
+		enumerator("pop", Opcode::pop), enumerator("compare", Opcode::compare), enumerator("shift", Opcode::shift),
+		enumerator("halt", Opcode::halt)));
+
+TEST_CASE("enum benchmark", "[rtti][!benchmark]")
+{
+	auto enumerators = rtti::get_type_view<Opcode>().enumerators();
+	std::vector<std::string_view> names;
+	for (size_t i = 0; i < 4096; ++i)
+		names.push_back((enumerators.begin() + (i * 7) % enumerators.size())->name());
+	int64_t sum = 0;
+
+	BENCHMARK("linear compare")
+	{
+		for (auto name : names)
+		{
+			auto e = std::find_if(enumerators.begin(), enumerators.end(), [name](const auto& e) { return e.name() == name; });
+			sum += e->value();
+		}
+	}
+	BENCHMARK("enum_value")
+	{
+		for (auto name : names)
+			sum += static_cast<int64_t>(*rtti::enum_value<Opcode>(name));
+	}
+	BENCHMARK("enum_name")
+	{
+		for (size_t i = 0; i < names.size(); ++i)
+			sum += rtti::enum_name(static_cast<Opcode>(i & 15)).size();
+	}
+	CHECK(sum > 0);
+}
+
+struct Fields50
+{
+	int		m_0 = 0;
+	float		m_1 = 1;
+	int		m_2 = 2;
+	float		m_3 = 3;
+	int		m_4 = 4;
+	float		m_5 = 5;
+	int		m_6 = 6;
+	float		m_7 = 7;
+	int		m_8 = 8;
+	float		m_9 = 9;
+	int		m_10 = 10;
+	float		m_11 = 11;
+	int		m_12 = 12;
+	float		m_13 = 13;
+	int		m_14 = 14;
+	float		m_15 = 15;
+	int		m_16 = 16;
+	float		m_17 = 17;
+	int		m_18 = 18;
+	float		m_19 = 19;
+	int		m_20 = 20;
+	float		m_21 = 21;
+	int		m_22 = 22;
+	float		m_23 = 23;
+	int		m_24 = 24;
+	float		m_25 = 25;
+	int		m_26 = 26;
+	float		m_27 = 27;
+	int		m_28 = 28;
+	float		m_29 = 29;
+	int		m_30 = 30;
+	float		m_31 = 31;
+	int		m_32 = 32;
+	float		m_33 = 33;
+	int		m_34 = 34;
+	float		m_35 = 35;
+	int		m_36 = 36;
+	float		m_37 = 37;
+	int		m_38 = 38;
+	float		m_39 = 39;
+	int		m_40 = 40;
+	float		m_41 = 41;
+	int		m_42 = 42;
+	float		m_43 = 43;
+	int		m_44 = 44;
+	float		m_45 = 45;
+	int		m_46 = 46;
+	float		m_47 = 47;
+	int		m_48 = 48;
+	float		m_49 = 49;
+};
+rtti_impl(Fields50,
+	.properties(
+		property("0").member(&Fields50::m_0),
+		property("1").member(&Fields50::m_1),
+		property("2").member(&Fields50::m_2),
+		property("3").member(&Fields50::m_3),
+		property("4").member(&Fields50::m_4),
+		property("5").member(&Fields50::m_5),
+		property("6").member(&Fields50::m_6),
+		property("7").member(&Fields50::m_7),
+		property("8").member(&Fields50::m_8),
+		property("9").member(&Fields50::m_9),
+		property("10").member(&Fields50::m_10),
+		property("11").member(&Fields50::m_11),
+		property("12").member(&Fields50::m_12),
+		property("13").member(&Fields50::m_13),
+		property("14").member(&Fields50::m_14),
+		property("15").member(&Fields50::m_15),
+		property("16").member(&Fields50::m_16),
+		property("17").member(&Fields50::m_17),
+		property("18").member(&Fields50::m_18),
+		property("19").member(&Fields50::m_19),
+		property("20").member(&Fields50::m_20),
+		property("21").member(&Fields50::m_21),
+		property("22").member(&Fields50::m_22),
+		property("23").member(&Fields50::m_23),
+		property("24").member(&Fields50::m_24),
+		property("25").member(&Fields50::m_25),
+		property("26").member(&Fields50::m_26),
+		property("27").member(&Fields50::m_27),
+		property("28").member(&Fields50::m_28),
+		property("29").member(&Fields50::m_29),
+		property("30").member(&Fields50::m_30),
+		property("31").member(&Fields50::m_31),
+		property("32").member(&Fields50::m_32),
+		property("33").member(&Fields50::m_33),
+		property("34").member(&Fields50::m_34),
+		property("35").member(&Fields50::m_35),
+		property("36").member(&Fields50::m_36),
+		property("37").member(&Fields50::m_37),
+		property("38").member(&Fields50::m_38),
+		property("39").member(&Fields50::m_39),
+		property("40").member(&Fields50::m_40),
+		property("41").member(&Fields50::m_41),
+		property("42").member(&Fields50::m_42),
+		property("43").member(&Fields50::m_43),
+		property("44").member(&Fields50::m_44),
+		property("45").member(&Fields50::m_45),
+		property("46").member(&Fields50::m_46),
+		property("47").member(&Fields50::m_47),
+		property("48").member(&Fields50::m_48),
+		property("49").member(&Fields50::m_49)));
+
+// Records of the serialization benchmarks.
+std::vector<Record> make_records(size_t count)
+{
+	std::vector<Record> records(count);
+	for (int i = 0; i < (int)records.size(); ++i)
+	{
+		auto& record = records[i];
+		record.m_id = i;
+		record.m_score = i * 0.25;
+		record.m_name = "record " + std::to_string(i);
+		record.m_tags = { i, i + 1, i + 2 };
+		record.m_color = Color(i % 3);
+		record.m_active = i % 2 == 0;
+	}
+	return records;
+}
+
+// Average time of a run of f, in seconds, for figures which BENCHMARK does not report.
+template<typename F>
+double seconds_per_run(const F& f, int runs)
+{
+	auto begin = std::chrono::steady_clock::now();
+	for (int i = 0; i < runs; ++i)
+		f();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+	return elapsed.count() / runs;
+}
+
+template<typename F>
+double megabytes_per_second(size_t size, const F& f, int runs)
+{
+	return size / seconds_per_run(f, runs) / (1024 * 1024);
+}
+
+TEST_CASE("binary serialization benchmark", "[rtti][!benchmark]")
+{
+	std::vector<Fields50> objects(1024);
+	auto& type = rtti::get_type_view<Fields50>();
+	std::vector<char> buffer;
+	rtti::binary_writer writer;
+
+	auto per_property = [&]
+	{
+		buffer.clear();
+		for (auto& object : objects)
+		{
+			for (auto& property : type.properties())
+			{
+				auto value = property.get(&object);
+				auto data = static_cast<const char*>(rtti::value_ref(value).address());
+				buffer.insert(buffer.end(), data, data + property.value_type().size());
+			}
+		}
+	};
+	auto write = [&]
+	{
+		writer.clear();
+		for (auto& object : objects)
+			writer.write(object);
+	};
+	auto read = [&]
+	{
+		rtti::binary_reader reader(writer.data(), writer.size());
+		for (auto& object : objects)
+			reader.read(object);
+	};
+
+	BENCHMARK("property_view get per property")
+	{
+		per_property();
+	}
+	BENCHMARK("binary_writer")
+	{
+		write();
+	}
+	BENCHMARK("binary_reader")
+	{
+		read();
+	}
+	CHECK(buffer.size() == writer.size());
+	CHECK(rtti::serialization_plan::of(type).operations().size() == 1);
+
+	auto throughput = [&](const auto& f) { return megabytes_per_second(writer.size(), f, 64); };
+	WARN("per property " << throughput(per_property) << " MB/s, binary_writer " << throughput(write) << " MB/s, binary_reader " << throughput(read) << " MB/s");
+}
+
+TEST_CASE("json benchmark", "[rtti][!benchmark]")
+{
+	auto records = make_records(20000);
+	rtti::json_writer writer;
+	std::vector<Record> target;
+
+	auto write = [&]
+	{
+		writer.clear();
+		writer.write(records);
+	};
+	auto read = [&]
+	{
+		rtti::json_reader(writer.text()).read(target);
+	};
+	// The same reader on an index built without SIMD. The char by char reader which the index replaced is not kept.
+	auto read_scalar_index = [&]
+	{
+		rtti::json_reader(writer.text(), rtti::simd_level::scalar).read(target);
+	};
+	rtti::json_structural_index index;
+	auto index_scalar = [&] { index.build(writer.text(), rtti::simd_level::scalar); };
+	auto index_sse2 = [&] { index.build(writer.text(), rtti::simd_level::sse2); };
+	auto index_avx2 = [&] { index.build(writer.text(), rtti::simd_level::avx2); };
+
+	BENCHMARK("json_writer")
+	{
+		write();
+	}
+	BENCHMARK("json_reader")
+	{
+		read();
+	}
+	BENCHMARK("json_reader with scalar index")
+	{
+		read_scalar_index();
+	}
+	BENCHMARK("json_structural_index scalar")
+	{
+		index_scalar();
+	}
+	BENCHMARK("json_structural_index sse2")
+	{
+		index_sse2();
+	}
+	BENCHMARK("json_structural_index avx2")
+	{
+		index_avx2();
+	}
+	REQUIRE(target.size() == records.size());
+	CHECK(target.back().m_name == records.back().m_name);
+
+	auto throughput = [&](const auto& f) { return megabytes_per_second(writer.text().size(), f, 16); };
+	WARN(writer.text().size() / 1024 << " KB, json_writer " << throughput(write) << " MB/s, json_reader " << throughput(read)
+		<< " MB/s, json_reader with scalar index " << throughput(read_scalar_index) << " MB/s");
+	WARN("json_structural_index scalar " << throughput(index_scalar) << " MB/s, sse2 " << throughput(index_sse2)
+		<< " MB/s, avx2 " << throughput(index_avx2) << " MB/s");
+
+	// The same records repeated into a document of at least 100 MB, written and read once.
+	auto large_records = make_records(records.size() * (100 * 1024 * 1024 / writer.text().size() + 1));
+	rtti::json_writer large_writer;
+	std::vector<Record> large_target;
+	auto write_large = [&]
+	{
+		large_writer.clear();
+		large_writer.write(large_records);
+	};
+	auto read_large = [&]
+	{
+		rtti::json_reader(large_writer.text()).read(large_target);
+	};
+	auto write_seconds = seconds_per_run(write_large, 1);
+	auto read_seconds = seconds_per_run(read_large, 1);
+	double megabytes = large_writer.text().size() / (1024.0 * 1024);
+	WARN(megabytes << " MB, json_writer " << megabytes / write_seconds << " MB/s, json_reader " << megabytes / read_seconds << " MB/s");
+	CHECK(megabytes >= 100);
+	REQUIRE(large_target.size() == large_records.size());
+	CHECK(large_target.back().m_name == large_records.back().m_name);
+}
+
+TEST_CASE("archive benchmark", "[rtti][!benchmark]")
+{
+	auto records = make_records(20000);
+	rtti::archive_writer archive;
+	REQUIRE(archive.write(records));
+	rtti::binary_writer binary;
+	REQUIRE(binary.write(records));
+	std::vector<Record> target;
+	int64_t sum = 0;
+
+	// Deserializes every field, against opening the archive and reading the fields of one record in place.
+	auto binary_read = [&]
+	{
+		rtti::binary_reader(binary.data(), binary.size()).read(target);
+		sum += target[1234].m_id;
+	};
+	auto archive_open = [&]
+	{
+		rtti::archive_view<std::vector<Record>> view(archive.data(), archive.size());
+		auto record = view[1234];
+		sum += *record["id"].as<int>() + record["name"].string().size() + record["tags"].data<int>()[0];
+	};
+	auto archive_scan = [&]
+	{
+		rtti::archive_view<std::vector<Record>> view(archive.data(), archive.size());
+		auto& id = *rtti::get_type_view<Record>().properties().get("id");
+		for (size_t i = 0; i < view.size(); ++i)
+			sum += *view[i].field(id).as<int>();
+	};
+	auto archive_load = [&]
+	{
+		rtti::archive_view<std::vector<Record>>(archive.data(), archive.size()).load(target);
+		sum += target[1234].m_id;
+	};
+
+	BENCHMARK("binary_reader")
+	{
+		binary_read();
+	}
+	BENCHMARK("archive_view open")
+	{
+		archive_open();
+	}
+	BENCHMARK("archive_view scan")
+	{
+		archive_scan();
+	}
+	BENCHMARK("archive_view load")
+	{
+		archive_load();
+	}
+	REQUIRE(target.size() == records.size());
+	CHECK(target.back().m_name == records.back().m_name);
+
+	auto elapsed = [&](const auto& f) { return seconds_per_run(f, 16) * 1000000; };
+	WARN(archive.size() / 1024 << " KB archive, " << binary.size() / 1024 << " KB binary, binary_reader " << elapsed(binary_read)
+		<< " us, archive_view open " << elapsed(archive_open) << " us, scan " << elapsed(archive_scan) << " us, load " << elapsed(archive_load) << " us");
+	CHECK(sum != 0);
+}
+
+TEST_CASE("object pool benchmark", "[rtti][!benchmark]")
+{
+	constexpr int count = 10000;
+
+	auto& type = rtti::get_type_view<Base>();
+	rtti::object_pool pool(type);
+	std::vector<Base*> objects(count);
+
+	BENCHMARK("type_view instantiate and delete")
+	{
+		for (int i = 0; i < count; ++i)
+			objects[i] = rtti::value_cast_object<Base>(type.instantiate({ i }));
+		for (auto object : objects)
+			delete object;
+	}
+	BENCHMARK("object_pool create and destroy")
+	{
+		for (int i = 0; i < count; ++i)
+			objects[i] = rtti::value_cast_object<Base>(pool.create({ i }));
+		for (auto object : objects)
+			pool.destroy(object);
+	}
+	CHECK(pool.stats().live_count == 0);
+}